@@ -0,0 +1,103 @@
+#ifndef GDWG_COW_GRAPH_HPP
+#define GDWG_COW_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <atomic>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+namespace gdwg {
+	/* A graph<N, E> whose copies share one immutable graph until one of them is modified.
+	 *
+	 * Copying a cow_graph only copies a reference to the shared graph, so it is constant time
+	 * however large the graph is. Reads go through read(), and every modification goes through
+	 * mutate(), which first gives this cow_graph a private deep copy if any other copy still
+	 * shares its graph. A copy that is never modified never costs more than the reference.
+	 *
+	 * Like std::shared_ptr, different cow_graph objects may be read, copied and mutated from
+	 * different threads even while they share a graph, but a single cow_graph may not be mutated
+	 * while another thread uses it.
+	 */
+	template<typename N, typename E, typename Allocator = std::allocator<std::byte>>
+	class cow_graph {
+	public:
+		using graph_type = graph<N, E, Allocator>;
+		using value_type = typename graph_type::value_type;
+		using allocator_type = typename graph_type::allocator_type;
+
+		cow_graph()
+		: cow_graph(graph_type()) {}
+
+		cow_graph(std::initializer_list<N> il)
+		: cow_graph(graph_type(il)) {}
+
+		/* Complexity: Constant time, as g is moved into the shared storage.
+		 */
+		explicit cow_graph(graph_type g)
+		: graph_(std::allocate_shared<graph_type>(g.get_allocator(), std::move(g))) {}
+
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+			return graph_->get_allocator();
+		}
+
+		/* Complexity: Constant time.
+		 */
+		[[nodiscard]] auto read() const noexcept -> graph_type const& {
+			return *graph_;
+		}
+
+		[[nodiscard]] auto operator*() const noexcept -> graph_type const& {
+			return *graph_;
+		}
+
+		[[nodiscard]] auto operator->() const noexcept -> graph_type const* {
+			return graph_.get();
+		}
+
+		/* Complexity: Constant time if no other copy shares the graph, otherwise that of the graph
+		 * copy constructor.
+		 * The returned reference may be used to modify the graph until *this is next copied.
+		 */
+		auto mutate() -> graph_type& {
+			if (is_shared()) {
+				graph_ = std::allocate_shared<graph_type>(get_allocator(), *graph_);
+			}
+			else {
+				// use_count() is a relaxed load, so seeing the last other copy gone doesn't yet order
+				// this thread after that copy's reads. The fence does, pairing with the release the
+				// copy's destructor made when it dropped the count.
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+			return *graph_;
+		}
+
+		/* Whether another copy still shares the graph, so that the next mutate() will copy it.
+		 */
+		[[nodiscard]] auto is_shared() const noexcept -> bool {
+			return graph_.use_count() > 1;
+		}
+
+		[[nodiscard]] auto shares_graph_with(cow_graph const& other) const noexcept -> bool {
+			return graph_ == other.graph_;
+		}
+
+		/* Complexity: Constant time when both share a graph, otherwise that of the graph
+		 * comparison.
+		 */
+		[[nodiscard]] auto operator==(cow_graph const& other) const -> bool {
+			return shares_graph_with(other) or *graph_ == *other.graph_;
+		}
+
+		friend auto operator<<(std::ostream& os, cow_graph const& g) -> std::ostream& {
+			return os << *g.graph_;
+		}
+
+	private:
+		std::shared_ptr<graph_type> graph_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_COW_GRAPH_HPP
@@ -0,0 +1,731 @@
+#ifndef GDWG_FLAT_GRAPH_HPP
+#define GDWG_FLAT_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/sorted_unique.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	/* A directed weighted graph stored in sorted contiguous vectors instead of node-based sets. It
+	 * is meant for graphs that are read far more often than they are written.
+	 *
+	 * It offers only part of graph<N, E>'s interface: the constructors from nodes, insert_node,
+	 * insert_edge, insert_edges of sorted_unique input, replace_node, merge_replace_node,
+	 * erase_node, erase_edge, clear, is_node, empty, is_connected, nodes, weights, find,
+	 * connections, the iterators, comparison and extractor behave as they do there. value_type is
+	 * graph<N, E>::value_type, so the edges of a graph can be passed to insert_edges directly.
+	 *
+	 * Node values live in ascending order in nodes_, and edges refer to their endpoints by
+	 * position, so ordering edges by (from, to, weight) is an integer comparison that agrees with
+	 * ordering them by value. Lookups are binary searches and iteration is a linear scan.
+	 *
+	 * Inserted nodes and edges are buffered in small sorted vectors and merged in one linear pass
+	 * once a buffer outgrows pending_limit(), or by flush() and the other modifiers. Reads look in
+	 * both the sorted vectors and the buffers without changing either, so const member functions
+	 * never modify the graph. Erasing and replacing nodes rewrites the edge vector and costs
+	 * O(n + e).
+	 */
+	template<typename N, typename E>
+	class flat_graph {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+
+		/* 2.2 Constructors */
+		flat_graph() noexcept = default;
+
+		flat_graph(std::initializer_list<N> il)
+		: flat_graph(il.begin(), il.end()) {}
+
+		template<typename InputIt>
+		flat_graph(InputIt first, InputIt last) {
+			std::for_each(first, last, [this](auto const& n) { insert_node(n); });
+		}
+
+		flat_graph(flat_graph&& other) noexcept = default;
+		auto operator=(flat_graph&& other) noexcept -> flat_graph& = default;
+		flat_graph(flat_graph const& other) = default;
+		auto operator=(flat_graph const& other) -> flat_graph& = default;
+
+		class iterator;
+
+		/* 2.3 Modifiers */
+
+		/* Complexity: O(log (n) + p), where p is the number of buffered nodes, plus an amortised
+		 * share of the next merge.
+		 */
+		auto insert_node(N const& value) -> bool {
+			if (index_of(value) not_eq nodes_.size()) {
+				return false;
+			}
+			auto const pos = std::lower_bound(pending_nodes_.begin(), pending_nodes_.end(), value);
+			if (pos not_eq pending_nodes_.end() and not(value < *pos)) {
+				return false;
+			}
+			if (nodes_.size() + pending_nodes_.size() > std::numeric_limits<node_id>::max()) {
+				throw std::length_error("Cannot store more nodes than gdwg::flat_graph<N, E> has ids "
+				                        "for");
+			}
+			pending_nodes_.insert(pos, value);
+			if (pending_nodes_.size() > pending_limit()) {
+				merge_pending();
+			}
+			return true;
+		}
+
+		/* Complexity: O(log (n) + log (e) + p), where p is the number of buffered edges, plus an
+		 * amortised share of the next merge.
+		 */
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::insert_edge when"
+			                              " either src or dst node does not exist";
+			auto const from = index_of(src);
+			auto const to = index_of(dst);
+			if ((from == nodes_.size() and not is_pending_node(src))
+			    or (to == nodes_.size() and not is_pending_node(dst)))
+			{
+				throw std::runtime_error(error_msg);
+			}
+			if (from not_eq nodes_.size() and to not_eq nodes_.size()
+			    and std::binary_search(edges_.begin(),
+			                           edges_.end(),
+			                           edge_type{id(from), id(to), weight}))
+			{
+				return false;
+			}
+
+			auto const pending = value_type{src, dst, weight};
+			auto const pos =
+			   std::lower_bound(pending_edges_.begin(), pending_edges_.end(), pending, value_less);
+			if (pos not_eq pending_edges_.end() and not value_less(pending, *pos)) {
+				return false;
+			}
+			pending_edges_.insert(pos, pending);
+			if (pending_edges_.size() > pending_limit()) {
+				merge_pending();
+			}
+			return true;
+		}
+
+		/* Complexity: O(k) when the edges belong after every edge already in the graph, which is
+		 * the case when appending a sorted stream, otherwise O(k log (k) + e). Plus resolving the
+		 * k endpoints, and merging any buffered insertions first.
+		 * Edges already sorted by (from, to, weight) with no repeats are appended to edges_
+		 * directly, without going through the buffer. Input that turns out not to be sorted is
+		 * still inserted correctly, only slower. Nothing is inserted if any endpoint is missing.
+		 */
+		template<typename InputIt>
+		auto insert_edges(sorted_unique_t, InputIt first, InputIt last) -> std::size_t {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::insert_edges when"
+			                              " either src or dst node does not exist";
+			merge_pending();
+			auto edges = std::vector<edge_type>{};
+			if constexpr (std::forward_iterator<InputIt>) {
+				edges.reserve(static_cast<std::size_t>(std::distance(first, last)));
+			}
+			std::for_each(first, last, [&](value_type const& e) {
+				auto const from = index_of(e.from);
+				auto const to = index_of(e.to);
+				if (from == nodes_.size() or to == nodes_.size()) {
+					throw std::runtime_error(error_msg);
+				}
+				edges.push_back(edge_type{id(from), id(to), e.weight});
+			});
+
+			auto const old_size = edges_.size();
+			edges_.insert(edges_.end(),
+			              std::make_move_iterator(edges.begin()),
+			              std::make_move_iterator(edges.end()));
+			auto const middle = edges_.begin() + static_cast<std::ptrdiff_t>(old_size);
+			auto const not_increasing = [](auto const& a, auto const& b) { return not(a < b); };
+			auto const check_from = old_size == 0 ? middle : std::prev(middle);
+			if (std::adjacent_find(check_from, edges_.end(), not_increasing) not_eq edges_.end()) {
+				std::sort(middle, edges_.end());
+				std::inplace_merge(edges_.begin(), middle, edges_.end());
+				edges_.erase(std::unique(edges_.begin(), edges_.end()), edges_.end());
+			}
+			return edges_.size() - old_size;
+		}
+
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::replace_node on"
+			                              " a node that doesn't exist";
+			if (not is_node(old_data)) {
+				throw std::runtime_error(error_msg);
+			}
+
+			if (is_node(new_data)) {
+				return false;
+			}
+
+			insert_node(new_data);
+			merge_replace_node(old_data, new_data);
+			return true;
+		}
+
+		/* Complexity: O(n + e log (e))
+		 * Every edge of old_data is re-pointed at new_data, after which the edges are re-sorted and
+		 * the duplicates this produced are dropped.
+		 */
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::"
+			                              "merge_replace_node on old or new data if they"
+			                              " don't exist in the graph";
+			if (not is_node(old_data) or not is_node(new_data)) {
+				throw std::runtime_error(error_msg);
+			}
+
+			merge_pending();
+			auto const old_id = id(index_of(old_data));
+			auto const new_id = id(index_of(new_data));
+			if (old_id == new_id) {
+				return;
+			}
+			std::for_each(edges_.begin(), edges_.end(), [&](auto& e) {
+				e.from = e.from == old_id ? new_id : e.from;
+				e.to = e.to == old_id ? new_id : e.to;
+			});
+			std::sort(edges_.begin(), edges_.end());
+			edges_.erase(std::unique(edges_.begin(), edges_.end()), edges_.end());
+			remove_node(old_id);
+		}
+
+		/* Complexity: O(n + e)
+		 */
+		auto erase_node(N const& value) -> bool {
+			if (not is_node(value)) {
+				return false;
+			}
+			merge_pending();
+			auto const node = id(index_of(value));
+			std::erase_if(edges_, [node](auto const& e) { return e.from == node or e.to == node; });
+			remove_node(node);
+			return true;
+		}
+
+		/* Complexity: O(log (n) + e)
+		 * The edge is found by binary search, but erasing it shifts the edges after it.
+		 */
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::erase_edge on"
+			                              " src or dst if they don't exist in the graph";
+			if (not is_node(src) or not is_node(dst)) {
+				throw std::runtime_error(error_msg);
+			}
+
+			merge_pending();
+			auto const edge = edge_type{id(index_of(src)), id(index_of(dst)), weight};
+			auto const pos = std::lower_bound(edges_.begin(), edges_.end(), edge);
+			if (pos == edges_.end() or not(*pos == edge)) {
+				return false;
+			}
+			edges_.erase(pos);
+			return true;
+		}
+
+		/* Complexity: O(e + p), where p is the number of buffered edges.
+		 * The edge is erased from whichever of edges_ and the buffer holds it, which leaves the
+		 * iterator's positions pointing at the edge after it.
+		 */
+		auto erase_edge(iterator i) -> iterator {
+			if (i == end() or i == iterator{}) {
+				return end();
+			}
+			if (pending_first(i.edge_, i.pending_)) {
+				pending_edges_.erase(pending_edges_.begin() + static_cast<std::ptrdiff_t>(i.pending_));
+			}
+			else {
+				edges_.erase(edges_.begin() + static_cast<std::ptrdiff_t>(i.edge_));
+			}
+			return iterator(this, i.edge_, i.pending_);
+		}
+
+		/* Complexity: O(e + p), where p is the number of buffered edges.
+		 * The edges between i and s are exactly those between their positions in edges_ and in the
+		 * buffer, so both ranges are erased directly.
+		 */
+		auto erase_edge(iterator i, iterator s) -> iterator {
+			if (i == end() or i == iterator{}) {
+				return end();
+			}
+			edges_.erase(edges_.begin() + static_cast<std::ptrdiff_t>(i.edge_),
+			             edges_.begin() + static_cast<std::ptrdiff_t>(s.edge_));
+			pending_edges_.erase(pending_edges_.begin() + static_cast<std::ptrdiff_t>(i.pending_),
+			                     pending_edges_.begin() + static_cast<std::ptrdiff_t>(s.pending_));
+			return iterator(this, i.edge_, i.pending_);
+		}
+
+		auto clear() noexcept -> void {
+			nodes_.clear();
+			edges_.clear();
+			pending_nodes_.clear();
+			pending_edges_.clear();
+		}
+
+		/* Complexity: O(n + e)
+		 * Sizes the node and edge vectors for node_count nodes and edge_count edges, so that
+		 * merging insertions up to those counts doesn't reallocate them.
+		 */
+		auto reserve(std::size_t node_count, std::size_t edge_count) -> void {
+			nodes_.reserve(node_count);
+			edges_.reserve(edge_count);
+		}
+
+		/* Complexity: O(n + e + p log (n)), where p is the number of buffered edges.
+		 * Merges any buffered insertions, then gives back the spare room of every vector.
+		 */
+		auto shrink_to_fit() -> void {
+			merge_pending();
+			nodes_.shrink_to_fit();
+			edges_.shrink_to_fit();
+			pending_nodes_.shrink_to_fit();
+			pending_edges_.shrink_to_fit();
+		}
+
+		/* Merges every buffered insertion into the sorted vectors.
+		 * Complexity: O(n + e + p log (n)), where p is the number of buffered edges.
+		 */
+		auto flush() -> void {
+			merge_pending();
+		}
+
+		/* 2.4 Accessors */
+
+		/* Complexity: O(log (n) + log (p)), where p is the number of buffered nodes.
+		 */
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return index_of(value) not_eq nodes_.size() or is_pending_node(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.empty() and pending_nodes_.empty();
+		}
+
+		/* How many nodes and edges the merged vectors can hold before they reallocate.
+		 */
+		[[nodiscard]] auto node_capacity() const noexcept -> std::size_t {
+			return nodes_.capacity();
+		}
+		[[nodiscard]] auto edge_capacity() const noexcept -> std::size_t {
+			return edges_.capacity();
+		}
+
+		/* Complexity: O(log (n) + log (e) + log (p)), where p is the number of buffered edges.
+		 */
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::is_connected if"
+			                              " src or dst node don't exist in the graph";
+			if (not is_node(src) or not is_node(dst)) {
+				throw std::runtime_error(error_msg);
+			}
+			auto const [first, last] = edges_between(src, dst);
+			auto const [buffered_first, buffered_last] = pending_between(src, dst);
+			return first not_eq last or buffered_first not_eq buffered_last;
+		}
+
+		/* Complexity: O(n + p), where p is the number of buffered nodes.
+		 */
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto nodes = std::vector<N>{};
+			nodes.reserve(nodes_.size() + pending_nodes_.size());
+			std::merge(nodes_.begin(),
+			           nodes_.end(),
+			           pending_nodes_.begin(),
+			           pending_nodes_.end(),
+			           std::back_inserter(nodes));
+			return nodes;
+		}
+
+		/* Complexity: O(log (n) + log (e) + log (p) + w log (w)), where p is the number of buffered
+		 * edges and w is the number of returned weights.
+		 */
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::weights if src"
+			                              " or dst node don't exist in the graph";
+			if (not is_node(src) or not is_node(dst)) {
+				throw std::runtime_error(error_msg);
+			}
+			auto const [first, last] = edges_between(src, dst);
+			auto const [buffered_first, buffered_last] = pending_between(src, dst);
+			auto weights = std::vector<E>{};
+			weights.reserve(
+			   static_cast<std::size_t>((last - first) + (buffered_last - buffered_first)));
+			auto const weight_of = [](auto const& e) { return e.weight; };
+			std::transform(first, last, std::back_inserter(weights), weight_of);
+			std::transform(buffered_first, buffered_last, std::back_inserter(weights), weight_of);
+			std::inplace_merge(weights.begin(), weights.begin() + (last - first), weights.end());
+			return weights;
+		}
+
+		/* Complexity: O(log (n) + log (e) + log (p)), where p is the number of buffered edges.
+		 * An edge's position among the edges it is not stored with is found by binary search too.
+		 */
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const value = value_type{src, dst, weight};
+			auto const pending = static_cast<std::size_t>(
+			   std::lower_bound(pending_edges_.begin(), pending_edges_.end(), value, value_less)
+			   - pending_edges_.begin());
+			if (pending not_eq pending_edges_.size()
+			    and not value_less(value, pending_edges_[pending])) {
+				return iterator(this, edge_rank(value), pending);
+			}
+
+			auto const from = index_of(src);
+			auto const to = index_of(dst);
+			if (from == nodes_.size() or to == nodes_.size()) {
+				return end();
+			}
+			auto const edge = edge_type{id(from), id(to), weight};
+			auto const pos = std::lower_bound(edges_.begin(), edges_.end(), edge);
+			if (pos == edges_.end() or not(*pos == edge)) {
+				return end();
+			}
+			return iterator(this, static_cast<std::size_t>(pos - edges_.begin()), pending);
+		}
+
+		/* Complexity: O(log (e) + log (p) + d log (d)), where p is the number of buffered edges and
+		 * d is the out-degree of src.
+		 */
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const* const error_msg = "Cannot call gdwg::flat_graph<N, E>::connections if"
+			                              " src doesn't exist in the graph";
+			if (not is_node(src)) {
+				throw std::runtime_error(error_msg);
+			}
+			auto connections = std::vector<N>{};
+			if (auto const from = index_of(src); from not_eq nodes_.size()) {
+				auto const [first, last] = edges_from(id(from));
+				connections.reserve(static_cast<std::size_t>(last - first));
+				std::transform(first, last, std::back_inserter(connections), [this](auto const& e) {
+					return nodes_[e.to];
+				});
+			}
+			auto const middle = static_cast<std::ptrdiff_t>(connections.size());
+			auto const first = std::partition_point(pending_edges_.begin(),
+			                                        pending_edges_.end(),
+			                                        [&](auto const& e) { return e.from < src; });
+			auto const last = std::partition_point(first, pending_edges_.end(), [&](auto const& e) {
+				return not(src < e.from);
+			});
+			std::transform(first, last, std::back_inserter(connections), [](auto const& e) {
+				return e.to;
+			});
+			std::inplace_merge(connections.begin(), connections.begin() + middle, connections.end());
+			return connections;
+		}
+
+		/* 2.5 Iterator access */
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(this, 0, 0);
+		}
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, edges_.size(), pending_edges_.size());
+		}
+
+		/* 2.6 Comparisons */
+		/* Complexity: O(n + e + p), where p is the number of buffered nodes and edges.
+		 * Equal node vectors number their nodes identically, so once both graphs are merged the edge
+		 * vectors can be compared element by element. Otherwise their edges are compared by value.
+		 */
+		[[nodiscard]] auto operator==(flat_graph const& other) const -> bool {
+			if (pending_nodes_.empty() and pending_edges_.empty() and other.pending_nodes_.empty()
+			    and other.pending_edges_.empty())
+			{
+				return std::tie(nodes_, edges_) == std::tie(other.nodes_, other.edges_);
+			}
+			return nodes() == other.nodes()
+			       and std::equal(begin(),
+			                      end(),
+			                      other.begin(),
+			                      other.end(),
+			                      [](value_type const& a, value_type const& b) {
+				                      return std::tie(a.from, a.to, a.weight)
+				                             == std::tie(b.from, b.to, b.weight);
+			                      });
+		}
+
+		/* 2.7 Extractor*/
+		friend auto operator<<(std::ostream& os, flat_graph const& g) -> std::ostream& {
+			auto e = g.begin();
+			auto const last = g.end();
+			for (auto const& node : g.nodes()) {
+				os << node << " (\n";
+				for (; e not_eq last; ++e) {
+					auto const edge = *e;
+					if (node < edge.from) {
+						break;
+					}
+					os << "  " << edge.to << " | " << edge.weight << "\n";
+				}
+				os << ")\n";
+			}
+			return os;
+		}
+
+	private:
+		using node_id = std::uint32_t;
+
+		struct edge_type {
+			node_id from;
+			node_id to;
+			E weight;
+
+			auto operator==(edge_type const&) const -> bool = default;
+			auto operator<(edge_type const& other) const -> bool {
+				return std::tie(from, to, weight) < std::tie(other.from, other.to, other.weight);
+			}
+		};
+
+		using edge_iterator = typename std::vector<edge_type>::const_iterator;
+		using pending_iterator = typename std::vector<value_type>::const_iterator;
+
+		static constexpr auto min_pending = std::size_t{64};
+
+		std::vector<N> nodes_;
+		std::vector<edge_type> edges_;
+		// Sorted, and disjoint from nodes_ and edges_ respectively.
+		std::vector<N> pending_nodes_;
+		std::vector<value_type> pending_edges_;
+
+		static auto value_less(value_type const& first, value_type const& second) -> bool {
+			return std::tie(first.from, first.to, first.weight)
+			       < std::tie(second.from, second.to, second.weight);
+		}
+
+		[[nodiscard]] auto edge_less(edge_type const& first, value_type const& second) const -> bool {
+			return std::tie(nodes_[first.from], nodes_[first.to], first.weight)
+			       < std::tie(second.from, second.to, second.weight);
+		}
+
+		static auto id(std::size_t index) -> node_id {
+			return static_cast<node_id>(index);
+		}
+
+		/* Buffers are kept to about the square root of the graph's size, which balances the linear
+		 * cost of inserting into a buffer against the linear cost of merging it.
+		 */
+		[[nodiscard]] auto pending_limit() const -> std::size_t {
+			auto const size = static_cast<double>(nodes_.size() + edges_.size());
+			return std::max(min_pending, static_cast<std::size_t>(std::sqrt(size)));
+		}
+
+		/* Complexity: O(log (n))
+		 * The position of value in the merged nodes, or nodes_.size() if it isn't one of them.
+		 */
+		[[nodiscard]] auto index_of(N const& value) const -> std::size_t {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() or value < *it) {
+				return nodes_.size();
+			}
+			return static_cast<std::size_t>(it - nodes_.begin());
+		}
+
+		[[nodiscard]] auto is_pending_node(N const& value) const -> bool {
+			return std::binary_search(pending_nodes_.begin(), pending_nodes_.end(), value);
+		}
+
+		/* Complexity: O(log (e))
+		 */
+		[[nodiscard]] auto edges_from(node_id from) const -> std::pair<edge_iterator, edge_iterator> {
+			auto const first = std::partition_point(edges_.begin(),
+			                                        edges_.end(),
+			                                        [from](auto const& e) { return e.from < from; });
+			auto const last = std::partition_point(first, edges_.end(), [from](auto const& e) {
+				return e.from == from;
+			});
+			return std::make_pair(first, last);
+		}
+
+		/* Complexity: O(log (n) + log (e))
+		 * The merged edges from src to dst, which are none while either is still buffered.
+		 */
+		[[nodiscard]] auto edges_between(N const& src, N const& dst) const
+		   -> std::pair<edge_iterator, edge_iterator> {
+			auto const from = index_of(src);
+			auto const to = index_of(dst);
+			if (from == nodes_.size() or to == nodes_.size()) {
+				return std::make_pair(edges_.end(), edges_.end());
+			}
+			auto const [first, last] = edges_from(id(from));
+			auto const lower = std::partition_point(first, last, [&](auto const& e) {
+				return e.to < to;
+			});
+			auto const upper = std::partition_point(lower, last, [&](auto const& e) {
+				return e.to == to;
+			});
+			return std::make_pair(lower, upper);
+		}
+
+		/* Complexity: O(log (p)), where p is the number of buffered edges.
+		 * The buffered edges from src to dst.
+		 */
+		[[nodiscard]] auto pending_between(N const& src, N const& dst) const
+		   -> std::pair<pending_iterator, pending_iterator> {
+			auto const first = std::partition_point(pending_edges_.begin(),
+			                                        pending_edges_.end(),
+			                                        [&](auto const& e) {
+				                                        return std::tie(e.from, e.to)
+				                                               < std::tie(src, dst);
+			                                        });
+			auto const last = std::partition_point(first, pending_edges_.end(), [&](auto const& e) {
+				return not(src < e.from) and not(dst < e.to);
+			});
+			return std::make_pair(first, last);
+		}
+
+		/* Complexity: O(log (e))
+		 * How many merged edges come before value in iteration order.
+		 */
+		[[nodiscard]] auto edge_rank(value_type const& value) const -> std::size_t {
+			auto const pos = std::partition_point(edges_.begin(), edges_.end(), [&](auto const& e) {
+				return edge_less(e, value);
+			});
+			return static_cast<std::size_t>(pos - edges_.begin());
+		}
+
+		/* Whether the edge at (edge, pending) in iteration order is the buffered one. The two
+		 * vectors are disjoint, so whichever of their next edges is smaller comes first.
+		 */
+		[[nodiscard]] auto pending_first(std::size_t edge, std::size_t pending) const -> bool {
+			return pending < pending_edges_.size()
+			       and (edge == edges_.size() or not edge_less(edges_[edge], pending_edges_[pending]));
+		}
+
+		// Whether the edge before (edge, pending) in iteration order is the buffered one.
+		[[nodiscard]] auto pending_last(std::size_t edge, std::size_t pending) const -> bool {
+			return pending > 0
+			       and (edge == 0 or edge_less(edges_[edge - 1], pending_edges_[pending - 1]));
+		}
+
+		/* Complexity: O(n + e)
+		 * Drops node from nodes_ and renumbers the nodes after it. The caller must already have
+		 * removed every edge that touches it.
+		 */
+		auto remove_node(node_id node) -> void {
+			nodes_.erase(nodes_.begin() + static_cast<std::ptrdiff_t>(node));
+			std::for_each(edges_.begin(), edges_.end(), [node](auto& e) {
+				e.from = e.from > node ? e.from - 1 : e.from;
+				e.to = e.to > node ? e.to - 1 : e.to;
+			});
+		}
+
+		/* Complexity: O(n + e + p log (n)), where p is the number of buffered edges.
+		 * Buffered nodes are merged first. Renumbering the existing nodes is monotonic, so the edges
+		 * stay sorted. The buffered edges are then resolved to node positions, which keeps them
+		 * sorted too, and merged in.
+		 */
+		auto merge_pending() -> void {
+			if (not pending_nodes_.empty()) {
+				// Keeps any room reserved by reserve().
+				auto merged = std::vector<N>{};
+				merged.reserve(std::max(nodes_.capacity(), nodes_.size() + pending_nodes_.size()));
+				auto renumbered = std::vector<node_id>(nodes_.size());
+				auto pending = pending_nodes_.begin();
+				for (auto i = std::size_t{0}; i < nodes_.size(); ++i) {
+					while (pending not_eq pending_nodes_.end() and *pending < nodes_[i]) {
+						merged.push_back(std::move(*pending++));
+					}
+					renumbered[i] = id(merged.size());
+					merged.push_back(std::move(nodes_[i]));
+				}
+				std::move(pending, pending_nodes_.end(), std::back_inserter(merged));
+				std::for_each(edges_.begin(), edges_.end(), [&](auto& e) {
+					e.from = renumbered[e.from];
+					e.to = renumbered[e.to];
+				});
+				nodes_ = std::move(merged);
+				pending_nodes_.clear();
+			}
+			if (not pending_edges_.empty()) {
+				auto const middle = static_cast<std::ptrdiff_t>(edges_.size());
+				std::transform(pending_edges_.begin(),
+				               pending_edges_.end(),
+				               std::back_inserter(edges_),
+				               [this](auto const& e) {
+					               return edge_type{id(index_of(e.from)), id(index_of(e.to)), e.weight};
+				               });
+				pending_edges_.clear();
+				std::inplace_merge(edges_.begin(), edges_.begin() + middle, edges_.end());
+			}
+		}
+
+	public:
+		/* 2.8 Iterator */
+		class iterator {
+		public:
+			using value_type = flat_graph::value_type;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				if (graph_->pending_first(edge_, pending_)) {
+					return graph_->pending_edges_[pending_];
+				}
+				auto const& e = graph_->edges_[edge_];
+				return value_type{graph_->nodes_[e.from], graph_->nodes_[e.to], e.weight};
+			}
+
+			auto operator++() -> iterator& {
+				if (graph_->pending_first(edge_, pending_)) {
+					++pending_;
+				}
+				else {
+					++edge_;
+				}
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+			auto operator--() -> iterator& {
+				if (graph_->pending_last(edge_, pending_)) {
+					--pending_;
+				}
+				else {
+					--edge_;
+				}
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				return std::tie(graph_, edge_, pending_)
+				       == std::tie(other.graph_, other.edge_, other.pending_);
+			}
+
+		private:
+			flat_graph const* graph_ = nullptr;
+			// Positions in edges_ and in the buffered edges; the edge is the smaller of the two.
+			std::size_t edge_ = 0;
+			std::size_t pending_ = 0;
+
+			friend class flat_graph;
+			iterator(flat_graph const* g, std::size_t edge, std::size_t pending)
+			: graph_(g)
+			, edge_(edge)
+			, pending_(pending) {}
+		};
+	};
+} // namespace gdwg
+
+#endif // GDWG_FLAT_GRAPH_HPP
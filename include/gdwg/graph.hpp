@@ -1,217 +1,712 @@
 #ifndef GDWG_GRAPH_HPP
 #define GDWG_GRAPH_HPP
 
+#include "gdwg/sorted_unique.hpp"
+
 #include <algorithm>
 #include <cassert>
+#include <concepts>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
 #include <set>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 
 // This will not compile straight away
 namespace gdwg {
+	/* When true, graph<N, E> keeps a hash index of its nodes next to the ordered node set, so that
+	 * resolving a node value costs expected O(1) instead of O(log (n)). It is on for every N that
+	 * std::hash supports; specialise it to false to trade the lookups back for the memory.
+	 */
+	template<typename N>
+	inline constexpr bool enable_hashed_node_index = requires(N const& value) {
+		{ std::hash<N>{}(value) } -> std::convertible_to<std::size_t>;
+	};
+
 	template<typename N, typename E>
+	class frozen_graph;
+
+	template<typename N, typename E, typename Allocator = std::allocator<std::byte>>
+	class graph;
+
+	/* What diff(a, b) found had to change to turn graph a into graph b. Every list is in ascending
+	 * order. An edge of a removed node counts as a removed edge too, and likewise for added ones.
+	 */
+	template<typename N, typename E, typename Allocator = std::allocator<std::byte>>
+	struct graph_diff {
+		using value_type = typename graph<N, E, Allocator>::value_type;
+
+		std::vector<N> added_nodes;
+		std::vector<N> removed_nodes;
+		std::vector<value_type> added_edges;
+		std::vector<value_type> removed_edges;
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return added_nodes.empty() and removed_nodes.empty() and added_edges.empty()
+			       and removed_edges.empty();
+		}
+	};
+
+	/* Every node, edge and index entry of the graph is allocated through a rebound copy of
+	 * Allocator, so a whole graph can be placed in an arena such as
+	 * std::pmr::monotonic_buffer_resource by using gdwg::pmr::graph. The allocator is not passed
+	 * on to N and E themselves.
+	 */
+	template<typename N, typename E, typename Allocator>
 	class graph {
 	public:
+		struct value_type {
+			N from;
+			N to;
+			E weight;
+		};
+
+		using allocator_type = Allocator;
+
 		/* 2.2 Constructors */
-		graph() noexcept = default;
+		graph() noexcept(noexcept(allocator_type()))
+		: graph(allocator_type()) {}
 
-		graph(std::initializer_list<N> il) {
-			*this = graph(il.begin(), il.end());
-		}
+		explicit graph(allocator_type const& alloc) noexcept
+		: nodes_(alloc)
+		, edges_(alloc)
+		, ids_(alloc)
+		, free_ids_(alloc)
+		, index_(alloc)
+		, dead_edges_(alloc) {}
+
+		graph(std::initializer_list<N> il, allocator_type const& alloc = allocator_type())
+		: graph(il.begin(), il.end(), alloc) {}
 
 		template<typename InputIt>
-		graph(InputIt first, InputIt last) {
+		graph(InputIt first, InputIt last, allocator_type const& alloc = allocator_type())
+		: graph(alloc) {
 			std::for_each(first, last, [this](auto const& n) { insert_node(n); });
 		}
 
-		graph(graph&& other) noexcept {
-			*this = std::move(other);
+		/* Complexity: O(k log (k)), where k is the number of edges in [first, last).
+		 * Builds the graph from edges instead of nodes. Every endpoint becomes a node, and then
+		 * the edges are bulk loaded as if by insert_edges().
+		 */
+		template<typename InputIt>
+		requires std::convertible_to<std::iter_reference_t<InputIt>, value_type const&>
+		graph(InputIt first, InputIt last, allocator_type const& alloc = allocator_type())
+		: graph(alloc) {
+			if constexpr (std::forward_iterator<InputIt>) {
+				auto endpoints = std::vector<N>{};
+				std::for_each(first, last, [&](value_type const& e) {
+					endpoints.push_back(e.from);
+					endpoints.push_back(e.to);
+				});
+				merge_nodes(endpoints);
+				insert_edges(first, last);
+			}
+			else {
+				auto const edges = std::vector<value_type>(first, last);
+				*this = graph(edges.begin(), edges.end(), alloc);
+			}
+		}
+
+		/* Complexity: Constant time.
+		 * The moved-from graph is left empty, and the new graph takes over its allocator.
+		 */
+		graph(graph&& other) noexcept
+		: nodes_(std::move(other.nodes_))
+		, edges_(std::move(other.edges_))
+		, ids_(std::move(other.ids_))
+		, free_ids_(std::move(other.free_ids_))
+		, index_(std::move(other.index_))
+		, dead_edges_(std::move(other.dead_edges_))
+		, max_dead_ratio_(other.max_dead_ratio_) {}
+
+		/* Complexity: Constant time if alloc compares equal to the allocator of other, otherwise
+		 * that of the copy constructor. Either way other is left empty.
+		 */
+		graph(graph&& other, allocator_type const& alloc)
+		: graph(alloc) {
+			if (get_allocator() == other.get_allocator()) {
+				*this = std::move(other);
+			}
+			else {
+				*this = graph(other, alloc);
+				other.clear();
+			}
 		}
 
-		auto operator=(graph&& other) noexcept -> graph& {
-			if (this not_eq &other) {
-				nodes_ = std::move(other.nodes_);
-				edges_ = std::move(other.edges_);
+		/* Nodes and edges can only be stolen from other when its allocator either comes along with
+		 * them or is interchangeable with ours. Otherwise they are copied into our own allocator.
+		 */
+		auto operator=(graph&& other) noexcept(steals_on_move_assignment) -> graph& {
+			if (this == &other) {
+				return *this;
+			}
+			if constexpr (not steals_on_move_assignment) {
+				if (get_allocator() not_eq other.get_allocator()) {
+					return *this = graph(std::move(other), get_allocator());
+				}
 			}
+			nodes_ = std::move(other.nodes_);
+			edges_ = std::move(other.edges_);
+			ids_ = std::move(other.ids_);
+			free_ids_ = std::move(other.free_ids_);
+			index_ = std::move(other.index_);
+			dead_edges_ = std::move(other.dead_edges_);
+			max_dead_ratio_ = other.max_dead_ratio_;
 			return *this;
 		}
 
-		graph(graph const& other) {
-			std::transform(other.nodes_.begin(),
-			               other.nodes_.end(),
-			               std::inserter(nodes_, nodes_.begin()),
-			               [](auto const& n) { return std::make_shared<N>(*n); });
-			std::transform(other.edges_.begin(),
-			               other.edges_.end(),
-			               std::inserter(edges_, edges_.begin()),
-			               [](auto const& e) { return std::make_shared<edge_type>(*e); });
+		graph(graph const& other)
+		: graph(other, alloc_traits::select_on_container_copy_construction(other.get_allocator())) {}
+
+		/* Complexity: O(n + e)
+		 * Edges refer to the nodes of the graph that owns them, so they are re-pointed at the freshly
+		 * copied nodes. The copies are looked up by the id of the original rather than by value.
+		 * Nodes and edges are visited in order, so each is appended at the end of its set, and each
+		 * edge at the end of the incoming index of its destination, without searching.
+		 */
+		graph(graph const& other, allocator_type const& alloc)
+		: graph(alloc) {
+			max_dead_ratio_ = other.max_dead_ratio_;
+			ids_.reserve(other.nodes_.size());
+			if constexpr (hashed_node_index) {
+				index_.reserve(other.index_.size());
+			}
+			auto copies = std::vector<node_type*>(other.ids_.size());
+			std::for_each(other.nodes_.begin(), other.nodes_.end(), [&](auto const& n) {
+				auto const copy = make_node(n->value);
+				nodes_.emplace_hint(nodes_.end(), copy);
+				adopt_node(*copy);
+				copies[n->id] = copy.get();
+			});
+			std::for_each(other.edges_.begin(), other.edges_.end(), [&](auto const& e) {
+				auto const to = copies[e.to->id];
+				auto const copy = edges_.emplace_hint(edges_.end(), copies[e.from->id], to, e.weight);
+				link_out(copy);
+				to->in_edges.emplace_hint(to->in_edges.end(), copy);
+			});
 		}
 
 		auto operator=(graph const& other) -> graph& {
 			if (this not_eq &other) {
-				std::transform(other.nodes_.begin(),
-				               other.nodes_.end(),
-				               std::inserter(nodes_, nodes_.begin()),
-				               [](auto const& n) { return std::make_shared<N>(*n); });
-				std::transform(other.edges_.begin(),
-				               other.edges_.end(),
-				               std::inserter(edges_, edges_.begin()),
-				               [](auto const& e) { return std::make_shared<edge_type>(*e); });
+				if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+					*this = graph(other, other.get_allocator());
+				}
+				else {
+					*this = graph(other, get_allocator());
+				}
 			}
 			return *this;
 		}
 
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+			return allocator_type(nodes_.get_allocator());
+		}
+
 		class iterator;
 
 		/* 2.3 Modifiers */
+		/* Complexity: O(log (n))
+		 */
 		auto insert_node(N const& value) -> bool {
-			auto const new_value = std::make_shared<N>(value);
-			return nodes_.emplace(new_value).second;
+			return insert_value(value);
+		}
+
+		/* Complexity: O(log (n))
+		 * value is moved into the new node, and left alone if it is already a node.
+		 */
+		auto insert_node(N&& value) -> bool {
+			return insert_value(std::move(value));
+		}
+
+		/* Complexity: O(log (n))
+		 * The value is constructed once from args, and moved into the new node only when it isn't
+		 * a node yet. Nothing is allocated otherwise.
+		 */
+		template<typename... Args>
+		auto emplace_node(Args&&... args) -> bool {
+			return insert_value(N(std::forward<Args>(args)...));
+		}
+
+		/* Complexity: O(k log (k) + n), where k is the number of values in [first, last).
+		 * Inserts every value that isn't a node yet and returns how many that was. The values are
+		 * sorted and deduplicated once, then merged into the node set in order so that each one is
+		 * placed with a hint instead of a full search.
+		 */
+		template<typename InputIt>
+		auto insert_nodes(InputIt first, InputIt last) -> std::size_t {
+			auto values = std::vector<N>(first, last);
+			return merge_nodes(values);
 		}
 
+		/* Complexity: O(log (e)) with the hashed node index, O(log (n) + log (e)) without.
+		 * Keeping the source's outgoing run up to date is constant time once the edge is placed.
+		 */
 		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
-			auto const error_msg = std::string("Cannot call gdwg::graph<N, E>::insert_edge when")
-			                          .append(" either src or dst node does not exist");
-			if (not is_node(src) or not is_node(dst)) {
-				throw std::runtime_error(error_msg);
+			if (auto const inserted = try_insert_edge(src, dst, weight)) {
+				return *inserted;
+			}
+			throw std::runtime_error(insert_edge_error);
+		}
+
+		/* Complexity: O(log (e)) with the hashed node index, O(log (n) + log (e)) without.
+		 * weight is moved into the new edge, and left alone if the edge already exists.
+		 */
+		auto insert_edge(N const& src, N const& dst, E&& weight) -> bool {
+			if (auto const inserted = try_insert_edge(src, dst, std::move(weight))) {
+				return *inserted;
+			}
+			throw std::runtime_error(insert_edge_error);
+		}
+
+		/* Each try_ member does the same as the member it is named after, except that a missing
+		 * node is reported by returning std::nullopt (or false, for try_merge_replace_node())
+		 * instead of by throwing. Neither version allocates anything to report the error.
+		 */
+		auto try_insert_edge(N const& src, N const& dst, E const& weight) -> std::optional<bool> {
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
+				return std::nullopt;
+			}
+			return insert_resolved_edge(from, to, weight);
+		}
+
+		auto try_insert_edge(N const& src, N const& dst, E&& weight) -> std::optional<bool> {
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
+				return std::nullopt;
+			}
+			return insert_resolved_edge(from, to, std::move(weight));
+		}
+
+		/* Complexity: O(log (e)) with the hashed node index, O(log (n) + log (e)) without.
+		 * The weight is constructed once from args, and moved into the new edge only when the edge
+		 * doesn't exist yet.
+		 */
+		template<typename... Args>
+		auto emplace_edge(N const& src, N const& dst, Args&&... args) -> bool {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::emplace_edge when"
+			                              " either src or dst node does not exist";
+			auto const [from, to] = resolve_endpoints(src, dst, error_msg);
+			return insert_resolved_edge(from, to, E(std::forward<Args>(args)...));
+		}
+
+		/* Complexity: O(k log (k) + e), where k is the number of edges in [first, last).
+		 * Inserts every edge that isn't in the graph yet and returns how many that was. Each
+		 * endpoint is resolved once, after which the edges are sorted and deduplicated and then
+		 * merged into edges_ in order. Nothing is inserted if any endpoint is missing.
+		 */
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::insert_edges when"
+			                              " either src or dst node does not exist";
+			auto edges = std::vector<edge_type>{};
+			if constexpr (std::forward_iterator<InputIt>) {
+				edges.reserve(static_cast<std::size_t>(std::distance(first, last)));
+			}
+			std::for_each(first, last, [&](value_type const& e) {
+				auto const from = find_node(e.from);
+				auto const to = find_node(e.to);
+				if (from == nullptr or to == nullptr) {
+					throw std::runtime_error(error_msg);
+				}
+				edges.push_back(edge_type{from, to, e.weight});
+			});
+			return merge_edges(edges);
+		}
+
+		/* Complexity: O(k) when the edges belong after every edge already in the graph, which is
+		 * the case when appending a sorted stream, otherwise at most O(k log (e)).
+		 * Like insert_edges(), but for edges that are already sorted by (from, to, weight) with no
+		 * repeats, so they are placed one after another without sorting or searching. Input that
+		 * turns out not to be sorted is still inserted correctly, only slower.
+		 */
+		template<typename InputIt>
+		auto insert_edges(sorted_unique_t, InputIt first, InputIt last) -> std::size_t {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::insert_edges when"
+			                              " either src or dst node does not exist";
+			auto edges = std::vector<edge_type>{};
+			if constexpr (std::forward_iterator<InputIt>) {
+				edges.reserve(static_cast<std::size_t>(std::distance(first, last)));
 			}
+			std::for_each(first, last, [&](value_type const& e) {
+				auto const [from, to] = resolve_endpoints(e.from, e.to, error_msg);
+				edges.push_back(edge_type{from, to, e.weight});
+			});
+			return merge_sorted_edges(edges);
+		}
 
-			auto const new_edge = std::make_shared<edge_type>();
-			new_edge->from = nodes_.find(src)->get();
-			new_edge->to = nodes_.find(dst)->get();
-			new_edge->weight = weight;
-			return edges_.emplace(new_edge).second;
+		/* Complexity: Amortised constant time when the edge belongs right before hint, such as
+		 * end() while appending edges in order, plus resolving src and dst. O(log (e)) otherwise.
+		 * Returns the inserted edge, or the equal edge that was already in the graph.
+		 */
+		auto insert_edge(iterator hint, N const& src, N const& dst, E const& weight) -> iterator {
+			auto const [from, to] = resolve_endpoints(src, dst, insert_edge_error);
+			auto const near = hint == iterator{} ? edges_.end() : hint.e_it_;
+			return iterator(insert_resolved_edge(near, from, to, weight).first);
 		}
 
+		/* Complexity: O(log (n) + d log (e))
+		 * The node is renamed in place, so it keeps its id and every edge keeps pointing at it.
+		 * Edges are ordered by the rank of their endpoints, so when new_data sorts between the same
+		 * two neighbours as old_data nothing has to move at all. Otherwise the d edges incident to
+		 * the node are taken out of edges_ as node handles while it is renamed, and put back.
+		 */
 		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			auto const error_msg = std::string("Cannot call gdwg::graph<N, E>::replace_node on a")
-			                          .append(" node that doesn't exist");
-			if (not is_node(old_data)) {
-				throw std::runtime_error(error_msg);
+			if (auto const replaced = try_replace_node(old_data, new_data)) {
+				return *replaced;
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that"
+			                         " doesn't exist");
+		}
+
+		auto try_replace_node(N const& old_data, N const& new_data) -> std::optional<bool> {
+			auto const position = nodes_.find(old_data);
+			if (position == nodes_.end()) {
+				return std::nullopt;
 			}
 
-			if (is_node(new_data)) {
+			if (find_node(new_data) not_eq nullptr) {
 				return false;
 			}
 
-			insert_node(new_data);
-			merge_replace_node(old_data, new_data);
+			auto const node = position->get();
+			auto value = N(new_data);
+			if constexpr (hashed_node_index) {
+				index_.erase(node);
+			}
+			if (keeps_rank(position, value)) {
+				node->value = std::move(value);
+			}
+			else {
+				auto detached = std::vector<detached_edge>{};
+				detached.reserve(node->in_edges.size() + node->out_degree);
+				while (not node->in_edges.empty()) {
+					detached.push_back(detach_edge(*node->in_edges.begin()));
+				}
+				while (node->out_degree > 0) {
+					detached.push_back(detach_edge(node->first_out));
+				}
+				auto handle = nodes_.extract(position);
+				handle.value()->value = std::move(value);
+				nodes_.insert(std::move(handle));
+				std::for_each(detached.begin(), detached.end(), [this](auto& d) {
+					attach_edge(std::move(d));
+				});
+			}
+			if constexpr (hashed_node_index) {
+				index_.insert(node);
+			}
 			return true;
 		}
 
+		/* Complexity: O(log (n) + d log (e))
+		 * Only the d edges incident to old_data are visited, found through its incoming index and
+		 * its outgoing run. Each is re-keyed in place by rekey_edge(), so nothing is allocated.
+		 */
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			auto const error_msg = std::string("Cannot call gdwg::graph<N, E>::merge_replace_node")
-			                          .append(" on old or new data if they don't exist in the graph");
-			if (not is_node(old_data) or not is_node(new_data)) {
-				throw std::runtime_error(error_msg);
+			if (not try_merge_replace_node(old_data, new_data)) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or"
+				                         " new data if they don't exist in the graph");
 			}
+		}
 
-			auto edges_to_replace = std::vector<std::shared_ptr<edge_type>>();
-			std::copy_if(
-			   edges_.begin(),
-			   edges_.end(),
-			   std::back_inserter(edges_to_replace),
-			   [old_data](auto const& e) { return *e->from == old_data or *e->to == old_data; });
-
-			std::for_each(edges_to_replace.begin(),
-			              edges_to_replace.end(),
-			              [this, old_data, new_data](auto const& e) {
-				              auto const new_edge = std::make_shared<edge_type>();
-				              new_edge->from = *e->from == old_data ? nodes_.find(new_data)->get()
-				                                                    : e->from;
-				              new_edge->to = *e->to == old_data ? nodes_.find(new_data)->get() : e->to;
-				              new_edge->weight = e->weight;
+		auto try_merge_replace_node(N const& old_data, N const& new_data) -> bool {
+			auto const old_node = find_node(old_data);
+			auto const new_node = find_node(new_data);
+			if (old_node == nullptr or new_node == nullptr) {
+				return false;
+			}
+			if (old_node == new_node) {
+				return true;
+			}
 
-				              edges_.emplace(new_edge);
-				              edges_.erase(e);
-			              });
+			// Re-keying an edge takes it out of old_node's incoming index or outgoing run, so both
+			// drain. Self-loops of old_node are both, and leave with the incoming ones.
+			while (not old_node->in_edges.empty()) {
+				auto const e = *old_node->in_edges.begin();
+				rekey_edge(e, e->from == old_node ? new_node : e->from, new_node);
+			}
+			while (old_node->out_degree > 0) {
+				auto const e = old_node->first_out;
+				rekey_edge(e, new_node, e->to);
+			}
 
-			nodes_.erase(nodes_.find(old_data));
+			drop_node(*old_node);
+			return true;
 		}
 
+		/* Complexity: O(log (n) + d log (e))
+		 * Only the d edges incident to value are erased, found through its incoming index and its
+		 * outgoing run.
+		 */
 		auto erase_node(N const& value) -> bool {
-			if (not is_node(value)) {
+			auto const node_to_remove = find_node(value);
+			if (node_to_remove == nullptr) {
 				return false;
 			}
-			auto node_to_remove = nodes_.find(value);
-			std::erase_if(edges_,
-			              [value](auto const& e) { return *e->from == value or *e->to == value; });
-			nodes_.erase(node_to_remove);
+			auto& node = *node_to_remove;
+			while (not node.in_edges.empty()) {
+				auto const e = *node.in_edges.begin();
+				unlink_edge(e);
+				edges_.erase(e);
+			}
+			while (node.out_degree > 0) {
+				auto const e = node.first_out;
+				unlink_edge(e);
+				edges_.erase(e);
+			}
+			drop_node(node);
 
 			return true;
 		}
 
-		/* Complexity: O(log (n) + e)
-		 * is_node() has a complexity of O(log (n))
-		 * std::find_if() has a complexity of O(e) since it iterates over the edges
+		/* Complexity: O(k log (n) + d log (e)), where k is the number of values in [first, last) and
+		 * d the number of edges incident to them.
+		 * Erases every node in [first, last) and returns how many there were. Values that aren't
+		 * nodes, or that repeat, are skipped. The doomed nodes are marked by id so that an edge
+		 * between two of them is erased once, and only ever fixes up the endpoint that survives.
+		 */
+		template<typename InputIt>
+		auto erase_nodes(InputIt first, InputIt last) -> std::size_t {
+			auto doomed = std::vector<node_type*>{};
+			auto is_doomed = std::vector<bool>(ids_.size(), false);
+			std::for_each(first, last, [&](N const& value) {
+				auto const node = find_node(value);
+				if (node not_eq nullptr and not is_doomed[node->id]) {
+					is_doomed[node->id] = true;
+					doomed.push_back(node);
+				}
+			});
+
+			// Incoming edges from a surviving source leave that source's run. Those from a doomed
+			// source stay in its run, which is intact until the second pass erases it whole.
+			std::for_each(doomed.begin(), doomed.end(), [&](node_type* node) {
+				std::for_each(node->in_edges.begin(), node->in_edges.end(), [&](auto const e) {
+					if (not is_doomed[e->from->id]) {
+						unlink_out(e);
+						edges_.erase(e);
+					}
+				});
+				node->in_edges.clear();
+			});
+			std::for_each(doomed.begin(), doomed.end(), [&](node_type* node) {
+				auto e = node->first_out;
+				while (node->out_degree > 0) {
+					if (not is_doomed[e->to->id]) {
+						e->to->in_edges.erase(e);
+					}
+					e = edges_.erase(e);
+					--node->out_degree;
+				}
+			});
+			std::for_each(doomed.begin(), doomed.end(), [this](node_type* node) { drop_node(*node); });
+			return doomed.size();
+		}
+
+		/* Complexity: O(log (e)) with the hashed node index, O(log (n) + log (e)) without.
+		 * Both endpoints are resolved once, after which std::set::find locates the edge itself.
 		 */
 		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
-			auto const error_msg = std::string("Cannot call gdwg::graph<N, E>::erase_edge on")
-			                          .append(" src or dst if they don't exist in the graph");
-			if (not is_node(src) or not is_node(dst)) {
-				throw std::runtime_error(error_msg);
+			if (auto const erased = try_erase_edge(src, dst, weight)) {
+				return *erased;
+			}
+			throw std::runtime_error(erase_edge_error);
+		}
+
+		auto try_erase_edge(N const& src, N const& dst, E const& weight) -> std::optional<bool> {
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
+				return std::nullopt;
 			}
 
-			auto const edge_to_remove =
-			   std::find_if(edges_.begin(), edges_.end(), [src, dst, weight](auto const& e) {
-				   return std::tie(*e->from, *e->to, e->weight) == std::tie(src, dst, weight);
-			   });
+			auto const edge_to_remove = edges_.find(edge_key{from, to, weight});
 			if (edge_to_remove == edges_.end()) {
 				return false;
 			}
-			edges_.erase(edge_to_remove);
+			retire_edge(edge_to_remove);
 			return true;
 		}
 
+		/* Complexity: O(k log (k) + e), where k is the number of edges in [first, last).
+		 * Erases every edge in [first, last) that is in the graph and returns how many that was.
+		 * Each endpoint is resolved before anything is erased, so nothing is erased if any endpoint
+		 * is missing.
+		 */
+		template<typename InputIt>
+		auto erase_edges(InputIt first, InputIt last) -> std::size_t {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::erase_edges on src or dst if"
+			                              " they don't exist in the graph";
+			auto edges = std::vector<edge_type>{};
+			if constexpr (std::forward_iterator<InputIt>) {
+				edges.reserve(static_cast<std::size_t>(std::distance(first, last)));
+			}
+			std::for_each(first, last, [&](value_type const& e) {
+				auto const [from, to] = resolve_endpoints(e.from, e.to, error_msg);
+				edges.push_back(edge_type{from, to, e.weight});
+			});
+			return purge_edges(edges);
+		}
+
 		/* Complexity: Amortised constant time.
 		 */
 		auto erase_edge(iterator i) -> iterator {
-			return i == end() or i == iterator{} ? end() : iterator(edges_.erase(i.e_it_));
+			if (i == end() or i == iterator{}) {
+				return end();
+			}
+			return iterator(retire_edge(i.e_it_));
 		}
 
 		/* Complexity O(d)
 		 */
 		auto erase_edge(iterator i, iterator s) -> iterator {
-			return i == end() or i == iterator{} ? end() : iterator(edges_.erase(i.e_it_, s.e_it_));
+			if (i == end() or i == iterator{}) {
+				return end();
+			}
+			auto it = i.e_it_;
+			while (it not_eq s.e_it_) {
+				it = retire_edge(it);
+			}
+			return iterator(it);
 		}
 
 		auto clear() noexcept -> void {
 			nodes_.clear();
 			edges_.clear();
+			ids_.clear();
+			free_ids_.clear();
+			if constexpr (hashed_node_index) {
+				index_.clear();
+			}
+			dead_edges_.clear();
+		}
+
+		/* Complexity: O(node_count)
+		 * Sizes the id table and the hashed node index for node_count nodes, so that inserting up to
+		 * that many neither reallocates the table nor rehashes the index. Nodes and edges are tree
+		 * nodes allocated one at a time, so there is nothing to reserve for them and edge_count is
+		 * accepted for symmetry with flat_graph<N, E>.
+		 */
+		auto reserve(std::size_t node_count, [[maybe_unused]] std::size_t edge_count) -> void {
+			ids_.reserve(node_count);
+			if constexpr (hashed_node_index) {
+				index_.reserve(node_count);
+			}
+		}
+
+		/* Complexity: O(n)
+		 * Gives back the spare room of the id table and the hashed node index. Released ids at the
+		 * end of the table are dropped as well, so the table shrinks to the highest id in use.
+		 */
+		auto shrink_to_fit() -> void {
+			while (not ids_.empty() and ids_.back() == nullptr) {
+				ids_.pop_back();
+			}
+			std::erase_if(free_ids_, [this](auto const id) { return id >= ids_.size(); });
+			ids_.shrink_to_fit();
+			free_ids_.shrink_to_fit();
+			if constexpr (hashed_node_index) {
+				index_.rehash(0);
+			}
+		}
+
+		/* While max_dead_ratio() is above zero, erase_edge() and erase_edges() don't free an erased
+		 * edge but keep it as a tombstone, and the next inserted edge reuses its storage instead of
+		 * allocating. Tombstones sit outside the edge set and its indices, so iteration and lookups
+		 * never see them. As soon as there are more than max_dead_ratio() tombstones per edge in
+		 * the graph, they are all freed by compact(). The ratio is zero by default.
+		 */
+		[[nodiscard]] auto max_dead_ratio() const noexcept -> float {
+			return max_dead_ratio_;
+		}
+
+		auto max_dead_ratio(float ratio) -> void {
+			max_dead_ratio_ = ratio;
+			if (static_cast<float>(dead_edges_.size()) > ratio * static_cast<float>(edges_.size())) {
+				compact();
+			}
+		}
+
+		[[nodiscard]] auto dead_edge_count() const noexcept -> std::size_t {
+			return dead_edges_.size();
+		}
+
+		/* Complexity: O(k), where k is the number of tombstones.
+		 * Frees every tombstone.
+		 */
+		auto compact() noexcept -> void {
+			dead_edges_.clear();
 		}
 
 		/* 2.4 Accessors */
 
-		/* Complexity: O(log(n))
-		 * std::set::find has O(log(n)) complexity to search for a value in a set
+		/* Complexity: Expected constant time with the hashed node index, O(log(n)) without.
 		 */
 		[[nodiscard]] auto is_node(N const& value) const -> bool {
-			return nodes_.find(value) not_eq nodes_.end();
+			return find_node(value) not_eq nullptr;
 		}
 
 		[[nodiscard]] auto empty() const -> bool {
 			return nodes_.empty();
 		}
 
+		/* How many nodes the graph can hold before the id table reallocates or the hashed node index
+		 * rehashes.
+		 */
+		[[nodiscard]] auto node_capacity() const noexcept -> std::size_t {
+			if constexpr (hashed_node_index) {
+				auto const buckets = static_cast<float>(index_.bucket_count());
+				auto const indexed = static_cast<std::size_t>(buckets * index_.max_load_factor());
+				return std::min(ids_.capacity(), indexed);
+			}
+			else {
+				return ids_.capacity();
+			}
+		}
+
+		/* Every edge is allocated on its own, so the graph never has room for more edges than it
+		 * holds.
+		 */
+		[[nodiscard]] auto edge_capacity() const noexcept -> std::size_t {
+			return edges_.size();
+		}
+
+		/* Complexity: O(log (e)) plus resolving src and dst.
+		 * std::set::contains looks up the (src, dst) prefix of the edge key directly.
+		 */
 		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
-			auto const error_msg = std::string("Cannot call gdwg::graph<N, E>::is_connected if src")
-			                          .append(" or dst node don't exist in the graph");
-			if (not is_node(src) or not is_node(dst)) {
-				throw std::runtime_error(error_msg);
+			if (auto const connected = try_is_connected(src, dst)) {
+				return *connected;
 			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst node"
+			                         " don't exist in the graph");
+		}
 
-			return std::any_of(edges_.begin(), edges_.end(), [&](auto const& e) {
-				return std::tie(*e->from, *e->to) == std::tie(src, dst);
-			});
+		[[nodiscard]] auto try_is_connected(N const& src, N const& dst) const -> std::optional<bool> {
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
+				return std::nullopt;
+			}
+			return edges_.contains(endpoints_key{from, to});
 		}
 
 		/* Complexity: O(n)
@@ -220,60 +715,168 @@ namespace gdwg {
 		[[nodiscard]] auto nodes() const -> std::vector<N> {
 			auto nodes = std::vector<N>{};
 			std::transform(nodes_.begin(), nodes_.end(), std::back_inserter(nodes), [](auto const& n) {
-				return *n;
+				return n->value;
 			});
 			return nodes;
 		}
 
-		/* Complexity: O(log (n) + e)
-		 * is_node() has O(log(n)) complexity by using std::set::find
-		 * std::for_each has O(e) complexity since it iterates over all the edges
+		/* Complexity: O(log (e) + w) plus resolving src and dst, where w is the number of weights.
+		 * std::set::equal_range finds the run of edges with the (src, dst) prefix directly.
 		 */
 		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
-			auto const error_msg = std::string("Cannot call gdwg::graph<N, E>::weights if src")
-			                          .append(" or dst node don't exist in the graph");
-			if (not is_node(src) or not is_node(dst)) {
-				throw std::runtime_error(error_msg);
+			if (auto weights = try_weights(src, dst)) {
+				return std::move(*weights);
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node don't"
+			                         " exist in the graph");
+		}
+
+		[[nodiscard]] auto try_weights(N const& src, N const& dst) const
+		   -> std::optional<std::vector<E>> {
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
+				return std::nullopt;
 			}
+			auto const [first, last] = edges_.equal_range(endpoints_key{from, to});
 			auto weights = std::vector<E>{};
-			std::for_each(edges_.begin(), edges_.end(), [&](auto const& e) {
-				if (std::tie(*e->from, *e->to) == std::tie(src, dst)) {
-					weights.push_back(e->weight);
-				}
+			std::transform(first, last, std::back_inserter(weights), [](auto const& e) {
+				return e.weight;
 			});
 			return weights;
 		}
 
-		/* Complexity:  O(log (n) + log (e))
-		 * is_node() has O(log(n)) complexity by using std::set::find
+		/* Complexity: O(log (e)) with the hashed node index, O(log (n) + log (e)) without.
 		 * std::set::find has O(log(e)) complexity to search for an edge in a set
 		 */
 		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
-			if (not is_node(src) or not is_node(dst)) {
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
 				return end();
 			}
-			return iterator(edges_.find(value_type{src, dst, weight}));
+			return iterator(edges_.find(edge_key{from, to, weight}));
 		}
 
-		/* Complexity:  O(log (n) + e)
-		 * is_node() has O(log(n)) complexity by using std::set::find
-		 * std::for_each has O(e) complexity since it iterates over all the edges
+		/* Complexity: O(e) plus resolving src
+		 * std::for_each_n has O(e) complexity, where e is the out-degree of src, since it only walks
+		 * the run of edges leaving src
 		 */
 		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
-			auto const error_msg = std::string("Cannot call gdwg::graph<N, E>::connections if src")
-			                          .append(" doesn't exist in the graph");
-			if (not is_node(src)) {
-				throw std::runtime_error(error_msg);
+			if (auto connections = try_connections(src)) {
+				return std::move(*connections);
+			}
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't exist"
+			                         " in the graph");
+		}
+
+		[[nodiscard]] auto try_connections(N const& src) const -> std::optional<std::vector<N>> {
+			auto const node = find_node(src);
+			if (node == nullptr) {
+				return std::nullopt;
 			}
 			auto connections = std::vector<N>{};
-			std::for_each(edges_.begin(), edges_.end(), [&](auto const& e) {
-				if (*e->from == src) {
-					connections.push_back(*e->to);
-				}
+			connections.reserve(node->out_degree);
+			std::for_each_n(node->first_out, node->out_degree, [&](auto const& e) {
+				connections.push_back(e.to->value);
 			});
 			return connections;
 		}
 
+		/* Complexity: O(e) plus resolving dst
+		 * std::transform has O(e) complexity, where e is the in-degree of dst
+		 */
+		[[nodiscard]] auto predecessors(N const& dst) const -> std::vector<N> {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::predecessors if dst"
+			                              " doesn't exist in the graph";
+			auto const node = find_node(dst);
+			if (node == nullptr) {
+				throw std::runtime_error(error_msg);
+			}
+			auto predecessors = std::vector<N>{};
+			predecessors.reserve(node->in_edges.size());
+			std::transform(node->in_edges.begin(),
+			               node->in_edges.end(),
+			               std::back_inserter(predecessors),
+			               [](auto const& e) { return e->from->value; });
+			return predecessors;
+		}
+
+		/* Complexity: O(e) plus resolving dst
+		 * std::transform has O(e) complexity, where e is the in-degree of dst
+		 */
+		[[nodiscard]] auto in_edges(N const& dst) const -> std::vector<value_type> {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::in_edges if dst"
+			                              " doesn't exist in the graph";
+			auto const node = find_node(dst);
+			if (node == nullptr) {
+				throw std::runtime_error(error_msg);
+			}
+			auto in_edges = std::vector<value_type>{};
+			in_edges.reserve(node->in_edges.size());
+			std::transform(node->in_edges.begin(),
+			               node->in_edges.end(),
+			               std::back_inserter(in_edges),
+			               [](auto const& e) {
+				               return value_type{e->from->value, e->to->value, e->weight};
+			               });
+			return in_edges;
+		}
+
+		/* Complexity: O(log (e)) plus resolving src and dst.
+		 * The edges from src to dst, in order of weight.
+		 */
+		[[nodiscard]] auto edges_between(N const& src, N const& dst) const
+		   -> std::ranges::subrange<iterator> {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::edges_between if src"
+			                              " or dst node don't exist in the graph";
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
+				throw std::runtime_error(error_msg);
+			}
+			auto const [first, last] = edges_.equal_range(endpoints_key{from, to});
+			return std::ranges::subrange<iterator>(iterator(first), iterator(last));
+		}
+
+		/* Complexity: O(log (e)) plus resolving src.
+		 * The edges leaving src, in the same order as iteration visits them.
+		 */
+		[[nodiscard]] auto edges_from(N const& src) const -> std::ranges::subrange<iterator> {
+			auto const* const error_msg = "Cannot call gdwg::graph<N, E>::edges_from if src"
+			                              " doesn't exist in the graph";
+			auto const from = find_node(src);
+			if (from == nullptr) {
+				throw std::runtime_error(error_msg);
+			}
+			auto const [first, last] = edges_.equal_range(source_key{from});
+			return std::ranges::subrange<iterator>(iterator(first), iterator(last));
+		}
+
+		/* Complexity: O(n + e)
+		 * Nodes are numbered by their position in nodes_, which is ascending order, so every row of
+		 * the snapshot comes out of edges_ already sorted by destination and weight.
+		 */
+		[[nodiscard]] auto freeze() const -> frozen_graph<N, E> {
+			using frozen_id = typename frozen_graph<N, E>::node_id;
+			auto frozen = frozen_graph<N, E>{};
+			auto rank = std::vector<frozen_id>(ids_.size());
+			frozen.nodes_.reserve(nodes_.size());
+			frozen.offsets_.reserve(nodes_.size() + 1);
+			std::for_each(nodes_.begin(), nodes_.end(), [&](auto const& n) {
+				rank[n->id] = static_cast<frozen_id>(frozen.nodes_.size());
+				frozen.nodes_.push_back(n->value);
+				frozen.offsets_.push_back(frozen.offsets_.back() + n->out_degree);
+			});
+			frozen.targets_.reserve(edges_.size());
+			frozen.weights_.reserve(edges_.size());
+			std::for_each(edges_.begin(), edges_.end(), [&](auto const& e) {
+				frozen.targets_.push_back(rank[e.to->id]);
+				frozen.weights_.push_back(e.weight);
+			});
+			return frozen;
+		}
+
 		/* 2.5 Iterator access */
 		[[nodiscard]] auto begin() const -> iterator {
 			return iterator(edges_.begin());
@@ -293,103 +896,626 @@ namespace gdwg {
 			}
 			return std::all_of(nodes_.begin(),
 			                   nodes_.end(),
-			                   [&](auto const& n) { return other.is_node(*n); })
+			                   [&](auto const& n) { return other.is_node(n->value); })
 			       and std::all_of(edges_.begin(), edges_.end(), [&](auto const& e) {
-				           return other.find(*e->from, *e->to, e->weight) not_eq other.end();
+				           return other.find(e.from->value, e.to->value, e.weight)
+				                  not_eq other.end();
 			           });
 		}
 
+		/* Complexity: O(n + e)
+		 * nodes_ and edges_ are both kept in order of value, so one merge walk over each pair of
+		 * sets finds every difference without looking anything up. Edges of the two graphs are
+		 * compared by the values of their endpoints, as node ids are only meaningful within one
+		 * graph.
+		 */
+		[[nodiscard]] friend auto diff(graph const& a, graph const& b)
+		   -> graph_diff<N, E, Allocator> {
+			auto result = graph_diff<N, E, Allocator>{};
+			merge_walk(a.nodes_,
+			           b.nodes_,
+			           node_compare{},
+			           [&](auto const& n) { result.removed_nodes.push_back(n->value); },
+			           [&](auto const& n) { result.added_nodes.push_back(n->value); });
+			auto const edge_value = [](edge_type const& e) {
+				return value_type{e.from->value, e.to->value, e.weight};
+			};
+			merge_walk(a.edges_,
+			           b.edges_,
+			           [](edge_type const& first, edge_type const& second) {
+				           return std::tie(first.from->value, first.to->value, first.weight)
+				                  < std::tie(second.from->value, second.to->value, second.weight);
+			           },
+			           [&](auto const& e) { result.removed_edges.push_back(edge_value(e)); },
+			           [&](auto const& e) { result.added_edges.push_back(edge_value(e)); });
+			return result;
+		}
+
 		/* 2.7 Extractor*/
+		/* Complexity: O(n + e)
+		 * Each node prints its own run of outgoing edges, so every edge is printed exactly once, in
+		 * destination and weight order.
+		 */
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
 			std::for_each(g.nodes_.begin(), g.nodes_.end(), [&](auto const& src) {
-				os << *src << " (\n";
-				auto const connections = g.connections(*src);
-				std::for_each(connections.begin(), connections.end(), [&](auto const& dst) {
-					auto const weights = g.weights(*src, dst);
-					std::for_each(weights.begin(), weights.end(), [&](auto const& weight) {
-						os << "  " << dst << " | " << weight << "\n";
-					});
+				os << src->value << " (\n";
+				std::for_each_n(src->first_out, src->out_degree, [&](auto const& e) {
+					os << "  " << e.to->value << " | " << e.weight << "\n";
 				});
 				os << ")\n";
 			});
 			return os;
 		}
 
-		struct value_type {
-			N from;
-			N to;
-			E weight;
-		};
-
 	private:
+		using node_id = std::uint32_t;
+		static constexpr auto insert_edge_error = "Cannot call gdwg::graph<N, E>::insert_edge when"
+		                                          " either src or dst node does not exist";
+		static constexpr auto erase_edge_error = "Cannot call gdwg::graph<N, E>::erase_edge on src or"
+		                                         " dst if they don't exist in the graph";
+		using alloc_traits = std::allocator_traits<Allocator>;
+		template<typename T>
+		using rebind_alloc = typename alloc_traits::template rebind_alloc<T>;
+		static constexpr bool steals_on_move_assignment =
+		   alloc_traits::propagate_on_container_move_assignment::value
+		   or alloc_traits::is_always_equal::value;
+		static constexpr bool hashed_node_index = enable_hashed_node_index<N>;
+
+		struct node_type;
+
 		struct edge_type {
-			N* from;
-			N* to;
+			node_type* from;
+			node_type* to;
 			E weight;
 		};
 
 		struct node_compare {
 			using is_transparent = void;
-			auto operator()(std::shared_ptr<N> const& first, N const& second) const -> bool {
+			auto operator()(std::shared_ptr<node_type> const& first, N const& second) const -> bool {
 				assert(first not_eq nullptr);
-				return *first < second;
+				return first->value < second;
 			}
-			auto operator()(N const& first, std::shared_ptr<N> const& second) const -> bool {
+			auto operator()(N const& first, std::shared_ptr<node_type> const& second) const -> bool {
 				assert(second not_eq nullptr);
-				return first < *second;
+				return first < second->value;
 			}
-			auto operator()(std::shared_ptr<N> const& first, std::shared_ptr<N> const& second) const
-			   -> bool {
+			auto operator()(std::shared_ptr<node_type> const& first,
+			                std::shared_ptr<node_type> const& second) const -> bool {
 				assert(std::tie(first, second) not_eq std::make_tuple(nullptr, nullptr));
-				return *first < *second;
+				return first->value < second->value;
 			}
 		};
 
+		using node_set = std::set<std::shared_ptr<node_type>,
+		                          node_compare,
+		                          rebind_alloc<std::shared_ptr<node_type>>>;
+
+		/* Prefixes of the edge key, so that every edge leaving a node, or every edge between a pair
+		 * of nodes, can be found with a single search of edges_.
+		 */
+		struct source_key {
+			node_type const* from;
+		};
+
+		struct endpoints_key {
+			node_type const* from;
+			node_type const* to;
+		};
+
+		/* The whole key of an edge, with the weight borrowed rather than copied, so that an edge
+		 * can be looked up before any weight has been constructed for it.
+		 */
+		struct edge_key {
+			node_type const* from;
+			node_type const* to;
+			E const& weight;
+		};
+
+		/* Nodes are interned, so two endpoints are the same node exactly when they have the same id.
+		 * Edges still have to be ordered by node value, since that is the order iteration exposes,
+		 * but N is only compared for endpoints that actually differ. Comparisons between edges that
+		 * share a source, which is most of them during a descent, compare no N at all.
+		 */
 		struct edge_compare {
 			using is_transparent = void;
-			auto operator()(std::shared_ptr<edge_type> const& first,
-			                std::shared_ptr<edge_type> const& second) const -> bool {
-				assert(std::tie(first, second) not_eq std::make_tuple(nullptr, nullptr));
-				return std::tie(*first->from, *first->to, first->weight)
-				       < std::tie(*second->from, *second->to, second->weight);
+			auto operator()(edge_type const& first, edge_type const& second) const -> bool {
+				return less(first, second);
 			}
-			auto operator()(std::shared_ptr<edge_type> const& first, edge_type const& second) const
-			   -> bool {
-				assert(first not_eq nullptr);
-				return std::tie(*first->from, *first->to, first->weight)
-				       < std::tie(*second.from, *second.to, second.weight);
+			auto operator()(edge_type const& first, edge_key const& second) const -> bool {
+				return less(first, second);
 			}
-			auto operator()(edge_type const& first, std::shared_ptr<edge_type> const& second) const
-			   -> bool {
-				assert(second not_eq nullptr);
-				return std::tie(*first.from, *first.to, first.weight)
-				       < std::tie(*second->from, *second->to, second->weight);
+			auto operator()(edge_key const& first, edge_type const& second) const -> bool {
+				return less(first, second);
 			}
-			auto operator()(std::shared_ptr<edge_type> const& first, value_type const& second) const
-			   -> bool {
-				assert(first not_eq nullptr);
-				return std::tie(*first->from, *first->to, first->weight)
-				       < std::tie(second.from, second.to, second.weight);
+			auto operator()(edge_type const& first, source_key const& second) const -> bool {
+				return first.from not_eq second.from and first.from->value < second.from->value;
 			}
-			auto operator()(value_type const& first, std::shared_ptr<edge_type> const& second) const
-			   -> bool {
-				assert(second not_eq nullptr);
-				return std::tie(first.from, first.to, first.weight)
-				       < std::tie(*second->from, *second->to, second->weight);
+			auto operator()(source_key const& first, edge_type const& second) const -> bool {
+				return first.from not_eq second.from and first.from->value < second.from->value;
+			}
+			auto operator()(edge_type const& first, endpoints_key const& second) const -> bool {
+				if (first.from not_eq second.from) {
+					return first.from->value < second.from->value;
+				}
+				return first.to not_eq second.to and first.to->value < second.to->value;
+			}
+			auto operator()(endpoints_key const& first, edge_type const& second) const -> bool {
+				if (first.from not_eq second.from) {
+					return first.from->value < second.from->value;
+				}
+				return first.to not_eq second.to and first.to->value < second.to->value;
+			}
+
+			template<typename First, typename Second>
+			static auto less(First const& first, Second const& second) -> bool {
+				if (first.from->id not_eq second.from->id) {
+					return first.from->value < second.from->value;
+				}
+				if (first.to->id not_eq second.to->id) {
+					return first.to->value < second.to->value;
+				}
+				return first.weight < second.weight;
 			}
 		};
 
-		std::set<std::shared_ptr<N>, node_compare> nodes_;
-		std::set<std::shared_ptr<edge_type>, edge_compare> edges_;
+		/* Edges are owned by edges_ alone, so they are stored in its tree nodes by value.
+		 */
+		using edge_set = std::set<edge_type, edge_compare, rebind_alloc<edge_type>>;
 
-	public:
-		/* 2.8 Iterator */
-		class iterator {
-			using edge_it = typename std::set<std::shared_ptr<edge_type>, edge_compare>::iterator;
+		/* Orders the incoming edges of a single node. They all share a destination, so this ends up
+		 * comparing source and weight only.
+		 */
+		struct in_compare {
+			auto operator()(typename edge_set::iterator const& first,
+			                typename edge_set::iterator const& second) const -> bool {
+				return edge_compare::less(*first, *second);
+			}
+		};
 
-		public:
-			using value_type = graph<N, E>::value_type;
-			using reference = value_type;
+		using in_edge_set = std::set<typename edge_set::iterator,
+		                             in_compare,
+		                             rebind_alloc<typename edge_set::iterator>>;
+
+		/* An edge taken out of edges_ together with its entry in the incoming index, so that it can
+		 * be re-keyed and put back without allocating.
+		 */
+		struct detached_edge {
+			typename edge_set::node_type edge;
+			typename in_edge_set::node_type in_entry;
+		};
+
+		/* Since edges_ is ordered by source first, the outgoing edges of a node always form one
+		 * contiguous run in it. The node only has to remember where that run starts and how long it
+		 * is; first_out is meaningless while out_degree is zero. Incoming edges are scattered
+		 * throughout edges_, so they are indexed explicitly.
+		 */
+		struct node_type {
+			template<typename Value>
+			node_type(Value&& v, allocator_type const& alloc)
+			: value(std::forward<Value>(v))
+			, in_edges(alloc) {}
+
+			N value;
+			node_id id = 0;
+			typename edge_set::iterator first_out;
+			std::size_t out_degree = 0;
+			in_edge_set in_edges;
+		};
+
+		/* Complexity: O(log (d)), where d is the in-degree of the destination.
+		 * Must be called right after e has been inserted into edges_.
+		 */
+		auto link_edge(typename edge_set::iterator e) -> void {
+			link_out(e);
+			e->to->in_edges.insert(e);
+		}
+
+		/* Complexity: O(log (d)), where d is the in-degree of the destination.
+		 * Must be called right before e is erased from edges_.
+		 */
+		auto unlink_edge(typename edge_set::iterator e) -> void {
+			unlink_out(e);
+			e->to->in_edges.erase(e);
+		}
+
+		/* Complexity: Constant time.
+		 * Adds e to the outgoing run of its source.
+		 */
+		auto link_out(typename edge_set::iterator e) -> void {
+			auto& src = *e->from;
+			if (src.out_degree == 0 or edges_.key_comp()(*e, *src.first_out)) {
+				src.first_out = e;
+			}
+			++src.out_degree;
+		}
+
+		/* Complexity: Constant time.
+		 * Removes e from the outgoing run of its source. The edge after e is still part of the same
+		 * run whenever the run doesn't end at e.
+		 */
+		auto unlink_out(typename edge_set::iterator e) -> void {
+			auto& src = *e->from;
+			--src.out_degree;
+			if (src.first_out == e) {
+				src.first_out = std::next(e);
+			}
+		}
+
+		/* Complexity: O(log (e))
+		 */
+		auto detach_edge(typename edge_set::iterator e) -> detached_edge {
+			auto in_entry = e->to->in_edges.extract(e);
+			unlink_out(e);
+			return detached_edge{edges_.extract(e), std::move(in_entry)};
+		}
+
+		/* Complexity: O(log (e))
+		 * Puts a detached edge back. If an equal edge is already there, it is dropped instead.
+		 */
+		auto attach_edge(detached_edge&& d) -> void {
+			auto const result = edges_.insert(std::move(d.edge));
+			if (not result.inserted) {
+				return;
+			}
+			link_out(result.position);
+			d.in_entry.value() = result.position;
+			result.position->to->in_edges.insert(std::move(d.in_entry));
+		}
+
+		/* Complexity: O(log (e))
+		 * Moves e to new endpoints without reallocating it.
+		 */
+		auto rekey_edge(typename edge_set::iterator e, node_type* from, node_type* to) -> void {
+			auto d = detach_edge(e);
+			d.edge.value().from = from;
+			d.edge.value().to = to;
+			attach_edge(std::move(d));
+		}
+
+		/* Complexity: Constant time.
+		 * Whether the node at position would still sort between the same neighbours if its value
+		 * were value.
+		 */
+		auto keeps_rank(typename node_set::iterator position, N const& value) const -> bool {
+			auto const next = std::next(position);
+			return (position == nodes_.begin() or (*std::prev(position))->value < value)
+			       and (next == nodes_.end() or value < (*next)->value);
+		}
+
+		/* Complexity: Amortised constant time.
+		 * Hands out the smallest-effort dense id: one released by erase_node if there is any,
+		 * otherwise the next unused one.
+		 */
+		auto intern(node_type& node) -> void {
+			if (not free_ids_.empty()) {
+				node.id = free_ids_.back();
+				free_ids_.pop_back();
+				ids_[node.id] = &node;
+				return;
+			}
+			if (ids_.size() > std::numeric_limits<node_id>::max()) {
+				throw std::length_error("Cannot intern more nodes than gdwg::graph<N, E> has ids for");
+			}
+			node.id = static_cast<node_id>(ids_.size());
+			ids_.push_back(&node);
+		}
+
+		template<typename Value>
+		auto make_node(Value&& value) const -> std::shared_ptr<node_type> {
+			auto const alloc = get_allocator();
+			return std::allocate_shared<node_type>(alloc, std::forward<Value>(value), alloc);
+		}
+
+		/* Complexity: O(log (n))
+		 * The position of value is found first, so a value that is already a node is turned away
+		 * before anything is allocated, and a new one is placed without searching again.
+		 */
+		template<typename Value>
+		auto insert_value(Value&& value) -> bool {
+			auto const hint = nodes_.lower_bound(value);
+			if (hint not_eq nodes_.end() and not(value < (*hint)->value)) {
+				return false;
+			}
+			auto const new_value = make_node(std::forward<Value>(value));
+			nodes_.emplace_hint(hint, new_value);
+			adopt_node(*new_value);
+			return true;
+		}
+
+		/* Complexity: O(log (e))
+		 * Like insert_value(), a duplicate edge is found before the weight is copied or anything is
+		 * allocated.
+		 */
+		template<typename Weight>
+		auto insert_resolved_edge(node_type* from, node_type* to, Weight&& weight) -> bool {
+			auto const key = edge_key{from, to, weight};
+			auto const hint = edges_.lower_bound(key);
+			if (hint not_eq edges_.end() and not edge_compare::less(key, *hint)) {
+				return false;
+			}
+			place_edge(hint, from, to, std::forward<Weight>(weight));
+			return true;
+		}
+
+		/* Complexity: Amortised constant time when the edge belongs right before hint, O(log (e))
+		 * otherwise.
+		 * The hinted version of the above. Returns the new edge, or the equal one already there.
+		 */
+		template<typename Weight>
+		auto insert_resolved_edge(typename edge_set::iterator hint,
+		                          node_type* from,
+		                          node_type* to,
+		                          Weight&& weight) -> std::pair<typename edge_set::iterator, bool> {
+			auto const key = edge_key{from, to, weight};
+			auto const position = lower_bound_near(hint, key);
+			if (position not_eq edges_.end() and not edge_compare::less(key, *position)) {
+				return {position, false};
+			}
+			return {place_edge(position, from, to, std::forward<Weight>(weight)), true};
+		}
+
+		/* Complexity: Amortised constant time when the edge belongs right before hint, O(log (e))
+		 * otherwise.
+		 * Inserts a new edge, reusing the storage of a tombstone when there is one.
+		 */
+		template<typename Weight>
+		auto place_edge(typename edge_set::iterator hint,
+		                node_type* from,
+		                node_type* to,
+		                Weight&& weight) -> typename edge_set::iterator {
+			if (dead_edges_.empty()) {
+				auto const e = edges_.emplace_hint(hint, from, to, std::forward<Weight>(weight));
+				link_edge(e);
+				return e;
+			}
+			auto& dead = dead_edges_.back();
+			auto& edge = dead.edge.value();
+			edge.from = from;
+			edge.to = to;
+			edge.weight = std::forward<Weight>(weight);
+			auto const e = edges_.insert(hint, std::move(dead.edge));
+			link_out(e);
+			dead.in_entry.value() = e;
+			e->to->in_edges.insert(std::move(dead.in_entry));
+			dead_edges_.pop_back();
+			return e;
+		}
+
+		/* Complexity: O(log (d)), where d is the in-degree of the destination.
+		 * Takes e out of the graph and returns the edge after it. While max_dead_ratio() is above
+		 * zero, e is kept as a tombstone instead of being freed.
+		 */
+		auto retire_edge(typename edge_set::iterator e) -> typename edge_set::iterator {
+			auto const next = std::next(e);
+			if (max_dead_ratio_ <= 0) {
+				unlink_edge(e);
+				edges_.erase(e);
+				return next;
+			}
+			// The slot is made first, so that e is never detached without a place to go.
+			auto& slot = dead_edges_.emplace_back();
+			slot = detach_edge(e);
+			auto const live = static_cast<float>(edges_.size());
+			if (static_cast<float>(dead_edges_.size()) > max_dead_ratio_ * live) {
+				compact();
+			}
+			return next;
+		}
+
+		/* Complexity: Constant time when hint is the lower bound of key, O(log (e)) otherwise.
+		 */
+		template<typename Key>
+		[[nodiscard]] auto lower_bound_near(typename edge_set::iterator hint, Key const& key) const
+		   -> typename edge_set::iterator {
+			auto const after = hint == edges_.end() or not edge_compare::less(*hint, key);
+			auto const before = hint == edges_.begin() or edge_compare::less(*std::prev(hint), key);
+			return after and before ? hint : edges_.lower_bound(key);
+		}
+
+		auto resolve_endpoints(N const& src, N const& dst, char const* error_msg) const
+		   -> std::pair<node_type*, node_type*> {
+			auto const from = find_node(src);
+			auto const to = find_node(dst);
+			if (from == nullptr or to == nullptr) {
+				throw std::runtime_error(error_msg);
+			}
+			return {from, to};
+		}
+
+		/* Complexity: Amortised constant time.
+		 * Must be called right after node has been inserted into nodes_.
+		 */
+		auto adopt_node(node_type& node) -> void {
+			intern(node);
+			if constexpr (hashed_node_index) {
+				index_.insert(&node);
+			}
+		}
+
+		/* Complexity: O(k log (k) + n), where k is the size of values.
+		 * Once values is sorted, the position of each one in nodes_ is at or after that of the one
+		 * before it. Inserting right before the hint is amortised constant time, so only a value
+		 * that lands past the hint costs a search. Loading into an empty graph never does.
+		 */
+		auto merge_nodes(std::vector<N>& values) -> std::size_t {
+			std::sort(values.begin(), values.end());
+			auto const equivalent = [](auto const& a, auto const& b) { return not(a < b); };
+			values.erase(std::unique(values.begin(), values.end(), equivalent), values.end());
+			if constexpr (hashed_node_index) {
+				index_.reserve(index_.size() + values.size());
+			}
+			auto inserted = std::size_t{0};
+			auto hint = nodes_.begin();
+			std::for_each(values.begin(), values.end(), [&](auto const& value) {
+				if (hint not_eq nodes_.end() and (*hint)->value < value) {
+					hint = nodes_.lower_bound(value);
+				}
+				if (hint not_eq nodes_.end() and not(value < (*hint)->value)) {
+					return;
+				}
+				auto const new_value = make_node(value);
+				hint = std::next(nodes_.emplace_hint(hint, new_value));
+				adopt_node(*new_value);
+				++inserted;
+			});
+			return inserted;
+		}
+
+		/* Complexity: O(k log (k) + e), where k is the size of edges.
+		 * The same hinted merge as merge_nodes(), into edges_.
+		 */
+		auto merge_edges(std::vector<edge_type>& edges) -> std::size_t {
+			std::sort(edges.begin(), edges.end(), edge_compare{});
+			auto const equivalent = [](auto const& a, auto const& b) {
+				return not edge_compare::less(a, b);
+			};
+			edges.erase(std::unique(edges.begin(), edges.end(), equivalent), edges.end());
+			return merge_sorted_edges(edges);
+		}
+
+		/* Complexity: O(k log (k) + e), where k is the size of edges.
+		 * Erases edges in sorted order, so that each is searched for starting from where the one
+		 * before it was.
+		 */
+		auto purge_edges(std::vector<edge_type>& edges) -> std::size_t {
+			std::sort(edges.begin(), edges.end(), edge_compare{});
+			auto erased = std::size_t{0};
+			auto hint = edges_.begin();
+			std::for_each(edges.begin(), edges.end(), [&](edge_type const& edge) {
+				hint = lower_bound_near(hint, edge);
+				if (hint not_eq edges_.end() and not edge_compare::less(edge, *hint)) {
+					hint = retire_edge(hint);
+					++erased;
+				}
+			});
+			return erased;
+		}
+
+		/* Complexity: O(k) when each edge belongs right after the one before it, otherwise at most
+		 * O(k log (e)), where k is the size of edges.
+		 * Each edge is placed using the position of the previous one as the hint.
+		 */
+		auto merge_sorted_edges(std::vector<edge_type>& edges) -> std::size_t {
+			auto inserted = std::size_t{0};
+			auto hint = edges_.begin();
+			std::for_each(edges.begin(), edges.end(), [&](auto& edge) {
+				auto const [e, is_new] =
+				   insert_resolved_edge(hint, edge.from, edge.to, std::move(edge.weight));
+				hint = std::next(e);
+				inserted += is_new ? 1 : 0;
+			});
+			return inserted;
+		}
+
+		/* Complexity: Amortised constant time.
+		 */
+		auto release(node_type const& node) -> void {
+			ids_[node.id] = nullptr;
+			free_ids_.push_back(node.id);
+		}
+
+		/* Visits the elements of two sets sorted by less in one pass, handing those only in a to
+		 * removed and those only in b to added.
+		 */
+		template<typename Set, typename Less, typename Removed, typename Added>
+		static auto merge_walk(Set const& a, Set const& b, Less less, Removed removed, Added added)
+		   -> void {
+			auto first = a.begin();
+			auto second = b.begin();
+			while (first not_eq a.end() and second not_eq b.end()) {
+				if (less(*first, *second)) {
+					removed(*first++);
+				}
+				else if (less(*second, *first)) {
+					added(*second++);
+				}
+				else {
+					++first;
+					++second;
+				}
+			}
+			std::for_each(first, a.end(), removed);
+			std::for_each(second, b.end(), added);
+		}
+
+		/* Hashes and compares nodes by value, and lets the index be searched by a bare N.
+		 */
+		struct node_hash {
+			using is_transparent = void;
+			auto operator()(node_type const* node) const -> std::size_t {
+				return std::hash<N>{}(node->value);
+			}
+			auto operator()(N const& value) const -> std::size_t {
+				return std::hash<N>{}(value);
+			}
+		};
+
+		struct node_equal {
+			using is_transparent = void;
+			auto operator()(node_type const* first, node_type const* second) const -> bool {
+				return first->value == second->value;
+			}
+			auto operator()(node_type const* first, N const& second) const -> bool {
+				return first->value == second;
+			}
+			auto operator()(N const& first, node_type const* second) const -> bool {
+				return first == second->value;
+			}
+		};
+
+		struct no_node_index {
+			explicit no_node_index(allocator_type const&) noexcept {}
+		};
+
+		using node_index = std::conditional_t<
+		   hashed_node_index,
+		   std::unordered_set<node_type*, node_hash, node_equal, rebind_alloc<node_type*>>,
+		   no_node_index>;
+
+		/* Complexity: Expected constant time with the hashed node index, O(log (n)) without.
+		 * Every public member resolves each node value it is given through here, exactly once.
+		 * Returns nullptr when value is not a node.
+		 */
+		[[nodiscard]] auto find_node(N const& value) const -> node_type* {
+			if constexpr (hashed_node_index) {
+				auto const node = index_.find(value);
+				return node == index_.end() ? nullptr : *node;
+			}
+			else {
+				auto const node = nodes_.find(value);
+				return node == nodes_.end() ? nullptr : node->get();
+			}
+		}
+
+		/* Complexity: O(log (n))
+		 * Removes a node once none of its edges are left.
+		 */
+		auto drop_node(node_type& node) -> void {
+			release(node);
+			if constexpr (hashed_node_index) {
+				index_.erase(&node);
+			}
+			nodes_.erase(nodes_.find(node.value));
+		}
+
+		node_set nodes_;
+		edge_set edges_;
+		// ids_[id] is the node interned as id, or nullptr while id is waiting in free_ids_ for reuse.
+		std::vector<node_type*, rebind_alloc<node_type*>> ids_;
+		std::vector<node_id, rebind_alloc<node_id>> free_ids_;
+		[[no_unique_address]] node_index index_;
+		// Erased edges kept for reuse, see max_dead_ratio().
+		std::vector<detached_edge, rebind_alloc<detached_edge>> dead_edges_;
+		float max_dead_ratio_ = 0;
+
+	public:
+		/* 2.8 Iterator */
+		class iterator {
+			using edge_it = typename edge_set::iterator;
+
+		public:
+			using value_type = graph::value_type;
+			using reference = value_type;
 			using pointer = void;
 			using difference_type = std::ptrdiff_t;
 			using iterator_category = std::bidirectional_iterator_tag;
@@ -398,9 +1524,9 @@ namespace gdwg {
 
 			auto operator*() const -> reference {
 				auto return_val = value_type{};
-				return_val.from = *((*e_it_)->from);
-				return_val.to = *((*e_it_)->to);
-				return_val.weight = (*e_it_)->weight;
+				return_val.from = e_it_->from->value;
+				return_val.to = e_it_->to->value;
+				return_val.weight = e_it_->weight;
 				return return_val;
 			}
 
@@ -433,8 +1559,410 @@ namespace gdwg {
 			explicit iterator(edge_it e_it)
 			: e_it_(e_it) {}
 		};
+
+		/* 2.9 Batch */
+		/* Records modifications of a graph and applies them together on commit(), with the same
+		 * result as making the same calls on the graph one after another.
+		 *
+		 * commit() first checks every operation against the nodes the graph will have at that
+		 * point, without touching the graph, and throws the error the matching graph member
+		 * would have thrown if any of them would fail. Only then does it apply them, a run of
+		 * consecutive operations of the same kind at a time: each run of node or edge insertions
+		 * is sorted and merged in one pass, as by insert_nodes() and insert_edges(), and each run
+		 * of erasures goes through erase_nodes() or one sorted sweep of the edges.
+		 */
+		class batch {
+		public:
+			explicit batch(graph& g) noexcept
+			: graph_(&g) {}
+
+			auto insert_node(N value) -> void {
+				operations_.emplace_back(insert_node_op{std::move(value)});
+			}
+			auto erase_node(N value) -> void {
+				operations_.emplace_back(erase_node_op{std::move(value)});
+			}
+			auto replace_node(N old_data, N new_data) -> void {
+				operations_.emplace_back(replace_node_op{std::move(old_data), std::move(new_data)});
+			}
+			auto insert_edge(N src, N dst, E weight) -> void {
+				auto edge = value_type{std::move(src), std::move(dst), std::move(weight)};
+				operations_.emplace_back(insert_edge_op{std::move(edge)});
+			}
+			auto erase_edge(N src, N dst, E weight) -> void {
+				auto edge = value_type{std::move(src), std::move(dst), std::move(weight)};
+				operations_.emplace_back(erase_edge_op{std::move(edge)});
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return operations_.size();
+			}
+
+			/* Complexity: O(k log (k)) for the k recorded operations, plus one merge of each run
+			 * into the graph.
+			 * The batch is empty again afterwards. If validation throws, neither the graph nor the
+			 * batch is changed.
+			 */
+			auto commit() -> void {
+				validate();
+				auto first = operations_.begin();
+				while (first not_eq operations_.end()) {
+					auto const kind = first->index();
+					auto const last = std::find_if(first, operations_.end(), [kind](auto const& op) {
+						return op.index() not_eq kind;
+					});
+					apply(first, last);
+					first = last;
+				}
+				operations_.clear();
+			}
+
+		private:
+			struct insert_node_op {
+				N value;
+			};
+			struct erase_node_op {
+				N value;
+			};
+			struct replace_node_op {
+				N old_data;
+				N new_data;
+			};
+			struct insert_edge_op {
+				value_type edge;
+			};
+			struct erase_edge_op {
+				value_type edge;
+			};
+
+			using operation = std::variant<insert_node_op,
+			                               erase_node_op,
+			                               replace_node_op,
+			                               insert_edge_op,
+			                               erase_edge_op>;
+			using operation_iterator = typename std::vector<operation>::iterator;
+
+			graph* graph_;
+			std::vector<operation> operations_;
+
+			/* Complexity: O(k log (k))
+			 * Replays the operations on a record of which nodes they add and remove, layered over
+			 * the nodes of the graph.
+			 */
+			auto validate() const -> void {
+				auto const* const replace_error = "Cannot call gdwg::graph<N, E>::replace_node on a"
+				                                  " node that doesn't exist";
+				auto exists = std::map<N, bool>{};
+				auto const is_node = [&](N const& value) {
+					auto const known = exists.find(value);
+					return known == exists.end() ? graph_->find_node(value) not_eq nullptr
+					                             : known->second;
+				};
+				std::for_each(operations_.begin(), operations_.end(), [&](operation const& op) {
+					if (auto const* insert = std::get_if<insert_node_op>(&op)) {
+						exists.insert_or_assign(insert->value, true);
+					}
+					else if (auto const* erase = std::get_if<erase_node_op>(&op)) {
+						exists.insert_or_assign(erase->value, false);
+					}
+					else if (auto const* replace = std::get_if<replace_node_op>(&op)) {
+						if (not is_node(replace->old_data)) {
+							throw std::runtime_error(replace_error);
+						}
+						if (not is_node(replace->new_data)) {
+							exists.insert_or_assign(replace->old_data, false);
+							exists.insert_or_assign(replace->new_data, true);
+						}
+					}
+					else if (auto const* insert_e = std::get_if<insert_edge_op>(&op)) {
+						if (not is_node(insert_e->edge.from) or not is_node(insert_e->edge.to)) {
+							throw std::runtime_error(insert_edge_error);
+						}
+					}
+					else if (auto const* erase_e = std::get_if<erase_edge_op>(&op)) {
+						if (not is_node(erase_e->edge.from) or not is_node(erase_e->edge.to)) {
+							throw std::runtime_error(erase_edge_error);
+						}
+					}
+				});
+			}
+
+			/* Applies [first, last), a run of validated operations that are all of the same kind.
+			 * Their values are moved out, since the batch is cleared afterwards.
+			 */
+			auto apply(operation_iterator first, operation_iterator last) -> void {
+				auto& g = *graph_;
+				if (std::holds_alternative<insert_node_op>(*first)) {
+					auto values = node_values<insert_node_op>(first, last);
+					g.merge_nodes(values);
+				}
+				else if (std::holds_alternative<erase_node_op>(*first)) {
+					auto const values = node_values<erase_node_op>(first, last);
+					g.erase_nodes(values.begin(), values.end());
+				}
+				else if (std::holds_alternative<replace_node_op>(*first)) {
+					std::for_each(first, last, [&g](operation const& op) {
+						auto const& replace = std::get<replace_node_op>(op);
+						g.try_replace_node(replace.old_data, replace.new_data);
+					});
+				}
+				else if (std::holds_alternative<insert_edge_op>(*first)) {
+					auto edges = resolved_edges<insert_edge_op>(first, last);
+					g.merge_edges(edges);
+				}
+				else {
+					auto edges = resolved_edges<erase_edge_op>(first, last);
+					g.purge_edges(edges);
+				}
+			}
+
+			template<typename Op>
+			static auto node_values(operation_iterator first, operation_iterator last)
+			   -> std::vector<N> {
+				auto values = std::vector<N>{};
+				values.reserve(static_cast<std::size_t>(last - first));
+				std::transform(first, last, std::back_inserter(values), [](operation& op) {
+					return std::move(std::get<Op>(op).value);
+				});
+				return values;
+			}
+
+			template<typename Op>
+			auto resolved_edges(operation_iterator first, operation_iterator last) const
+			   -> std::vector<edge_type> {
+				auto const* const error_msg =
+				   std::is_same_v<Op, insert_edge_op> ? insert_edge_error : erase_edge_error;
+				auto edges = std::vector<edge_type>{};
+				edges.reserve(static_cast<std::size_t>(last - first));
+				std::transform(first, last, std::back_inserter(edges), [&](operation& op) {
+					auto& e = std::get<Op>(op).edge;
+					auto const [from, to] = graph_->resolve_endpoints(e.from, e.to, error_msg);
+					return edge_type{from, to, std::move(e.weight)};
+				});
+				return edges;
+			}
+		};
 	};
 
+	/* An immutable compressed-sparse-row snapshot of a graph, produced by graph<N, E>::freeze().
+	 * Node values are stored once in ascending order and referred to by their position. The
+	 * outgoing edges of node i are targets_[offsets_[i], offsets_[i + 1]) together with the weights
+	 * at the same positions, sorted by destination and then weight. Every read is a binary search or
+	 * a linear scan over contiguous memory.
+	 */
+	template<typename N, typename E>
+	class frozen_graph {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+		using node_id = std::uint32_t;
+
+		frozen_graph() noexcept = default;
+
+		class iterator;
+
+		/* Complexity: O(log (n))
+		 */
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return std::binary_search(nodes_.begin(), nodes_.end(), value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return nodes_.empty();
+		}
+
+		/* Complexity: O(log (n) + log (e)), where e is the out-degree of src.
+		 */
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const* const error_msg = "Cannot call gdwg::frozen_graph<N, E>::is_connected if"
+			                              " src or dst node don't exist in the graph";
+			auto const [from, to] = locate(src, dst, error_msg);
+			auto const [first, last] = targets_of(from, to);
+			return first not_eq last;
+		}
+
+		/* Complexity: O(n)
+		 */
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return nodes_;
+		}
+
+		/* Complexity: O(log (n) + log (e) + w), where e is the out-degree of src and w is the
+		 * number of returned weights.
+		 */
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const* const error_msg = "Cannot call gdwg::frozen_graph<N, E>::weights if src"
+			                              " or dst node don't exist in the graph";
+			auto const [from, to] = locate(src, dst, error_msg);
+			auto const [first, last] = targets_of(from, to);
+			return std::vector<E>(weights_.begin() + (first - targets_.begin()),
+			                      weights_.begin() + (last - targets_.begin()));
+		}
+
+		/* Complexity: O(log (n) + log (e)), where e is the out-degree of src.
+		 */
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const from = index_of(src);
+			auto const to = index_of(dst);
+			if (from == nodes_.size() or to == nodes_.size()) {
+				return end();
+			}
+			auto const [first, last] = targets_of(from, to);
+			auto const weight_first = weights_.begin() + (first - targets_.begin());
+			auto const weight_last = weights_.begin() + (last - targets_.begin());
+			auto const match = std::lower_bound(weight_first, weight_last, weight);
+			if (match == weight_last or weight < *match) {
+				return end();
+			}
+			return iterator(this, static_cast<std::size_t>(match - weights_.begin()), from);
+		}
+
+		/* Complexity: O(log (n) + e), where e is the out-degree of src.
+		 */
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const* const error_msg = "Cannot call gdwg::frozen_graph<N, E>::connections if"
+			                              " src doesn't exist in the graph";
+			auto const from = index_of(src);
+			if (from == nodes_.size()) {
+				throw std::runtime_error(error_msg);
+			}
+			auto connections = std::vector<N>{};
+			connections.reserve(offsets_[from + 1] - offsets_[from]);
+			std::transform(targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[from]),
+			               targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[from + 1]),
+			               std::back_inserter(connections),
+			               [this](auto const to) { return nodes_[to]; });
+			return connections;
+		}
+
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(this, 0, 0);
+		}
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, targets_.size(), nodes_.size());
+		}
+
+		[[nodiscard]] auto operator==(frozen_graph const& other) const -> bool = default;
+
+		friend auto operator<<(std::ostream& os, frozen_graph const& g) -> std::ostream& {
+			for (auto from = std::size_t{0}; from < g.nodes_.size(); ++from) {
+				os << g.nodes_[from] << " (\n";
+				for (auto i = g.offsets_[from]; i < g.offsets_[from + 1]; ++i) {
+					os << "  " << g.nodes_[g.targets_[i]] << " | " << g.weights_[i] << "\n";
+				}
+				os << ")\n";
+			}
+			return os;
+		}
+
+		class iterator {
+		public:
+			using value_type = frozen_graph::value_type;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return value_type{graph_->nodes_[from_],
+				                  graph_->nodes_[graph_->targets_[edge_]],
+				                  graph_->weights_[edge_]};
+			}
+
+			// Moving past the last edge of a row also moves on to the next non-empty row.
+			auto operator++() -> iterator& {
+				++edge_;
+				skip_empty_rows();
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+			auto operator--() -> iterator& {
+				--edge_;
+				while (graph_->offsets_[from_] > edge_) {
+					--from_;
+				}
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				return std::tie(graph_, edge_) == std::tie(other.graph_, other.edge_);
+			}
+
+		private:
+			frozen_graph const* graph_ = nullptr;
+			std::size_t edge_ = 0;
+			std::size_t from_ = 0;
+
+			friend class frozen_graph;
+			iterator(frozen_graph const* g, std::size_t edge, std::size_t from)
+			: graph_(g)
+			, edge_(edge)
+			, from_(from) {
+				skip_empty_rows();
+			}
+
+			auto skip_empty_rows() -> void {
+				while (from_ < graph_->nodes_.size() and graph_->offsets_[from_ + 1] <= edge_) {
+					++from_;
+				}
+			}
+		};
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<std::size_t> offsets_ = std::vector<std::size_t>(1, 0);
+		std::vector<node_id> targets_;
+		std::vector<E> weights_;
+
+		template<typename, typename, typename>
+		friend class graph;
+
+		/* Complexity: O(log (n))
+		 * Returns nodes_.size() when value is not a node.
+		 */
+		[[nodiscard]] auto index_of(N const& value) const -> std::size_t {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() or value < *it) {
+				return nodes_.size();
+			}
+			return static_cast<std::size_t>(it - nodes_.begin());
+		}
+
+		[[nodiscard]] auto locate(N const& src, N const& dst, char const* error_msg) const
+		   -> std::pair<std::size_t, std::size_t> {
+			auto const from = index_of(src);
+			auto const to = index_of(dst);
+			if (from == nodes_.size() or to == nodes_.size()) {
+				throw std::runtime_error(error_msg);
+			}
+			return {from, to};
+		}
+
+		/* Complexity: O(log (e)), where e is the out-degree of from.
+		 * The range of targets_ in row from that are equal to to.
+		 */
+		[[nodiscard]] auto targets_of(std::size_t from, std::size_t to) const {
+			return std::equal_range(targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[from]),
+			                        targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[from + 1]),
+			                        static_cast<node_id>(to));
+		}
+	};
+
+	namespace pmr {
+		template<typename N, typename E>
+		using graph = gdwg::graph<N, E, std::pmr::polymorphic_allocator<std::byte>>;
+	} // namespace pmr
+
 } // namespace gdwg
 
 #endif // GDWG_GRAPH_HPP
@@ -0,0 +1,401 @@
+#ifndef GDWG_JOURNALED_GRAPH_HPP
+#define GDWG_JOURNALED_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace gdwg {
+	/* A graph<N, E> that records each modification made through it in a journal, so that it can be
+	 * undone, redone, or replayed onto another graph.
+	 *
+	 * Each entry is the delta of one modification, holding just enough to reverse it: the values
+	 * it was called with, plus the edges an erase_node() or merge_replace_node() took away, or the
+	 * whole graph for clear(). Undoing or redoing an entry therefore costs about as much as the
+	 * modification did, however large the graph is. A modification that didn't change the graph,
+	 * such as inserting an edge that already exists, isn't recorded.
+	 *
+	 * Reads go through read(). Modifying the graph other than through the members below would
+	 * leave the journal describing a different graph, so only a const reference is handed out.
+	 */
+	template<typename N, typename E, typename Allocator = std::allocator<std::byte>>
+	class journaled_graph {
+	public:
+		using graph_type = graph<N, E, Allocator>;
+		using value_type = typename graph_type::value_type;
+		using allocator_type = typename graph_type::allocator_type;
+
+		/* The deltas recorded by a journaled_graph, in the order they were made. Those that have
+		 * been undone stay in it until the next modification, so that redo() can apply them again.
+		 */
+		class journal {
+		public:
+			/* The number of deltas currently applied, which replay() applies in turn.
+			 */
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return applied_;
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return applied_ == 0;
+			}
+
+		private:
+			friend class journaled_graph;
+
+			struct insert_node_op {
+				N value;
+			};
+			struct erase_node_op {
+				N value;
+				std::vector<value_type> edges;
+			};
+			struct replace_node_op {
+				N old_data;
+				N new_data;
+			};
+			// added holds the re-keyed edges that weren't in the graph before, and so have to go
+			// again on undo. The others were merged into an edge new_data already had.
+			struct merge_replace_node_op {
+				N old_data;
+				N new_data;
+				std::vector<value_type> edges;
+				std::vector<value_type> added;
+			};
+			struct insert_edge_op {
+				value_type edge;
+			};
+			struct erase_edge_op {
+				value_type edge;
+			};
+			struct clear_op {
+				std::vector<N> nodes;
+				std::vector<value_type> edges;
+			};
+
+			using operation = std::variant<insert_node_op,
+			                               erase_node_op,
+			                               replace_node_op,
+			                               merge_replace_node_op,
+			                               insert_edge_op,
+			                               erase_edge_op,
+			                               clear_op>;
+
+			std::vector<operation> entries_;
+			std::size_t applied_ = 0;
+
+			// A new delta replaces every undone one, as there is no longer a graph to redo them on.
+			auto record(operation op) -> void {
+				auto const undone = entries_.begin() + static_cast<std::ptrdiff_t>(applied_);
+				entries_.erase(undone, entries_.end());
+				entries_.push_back(std::move(op));
+				++applied_;
+			}
+		};
+
+		journaled_graph()
+		: journaled_graph(graph_type()) {}
+
+		journaled_graph(std::initializer_list<N> il)
+		: journaled_graph(graph_type(il)) {}
+
+		/* The journal starts out empty, so g as given is as far back as undo() goes.
+		 */
+		explicit journaled_graph(graph_type g)
+		: graph_(std::move(g)) {}
+
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+			return graph_.get_allocator();
+		}
+
+		[[nodiscard]] auto read() const noexcept -> graph_type const& {
+			return graph_;
+		}
+
+		[[nodiscard]] auto operator*() const noexcept -> graph_type const& {
+			return graph_;
+		}
+
+		[[nodiscard]] auto operator->() const noexcept -> graph_type const* {
+			return &graph_;
+		}
+
+		[[nodiscard]] auto history() const noexcept -> journal const& {
+			return journal_;
+		}
+
+		/* Forgets every delta, so that the graph as it is now is as far back as undo() goes.
+		 */
+		auto clear_history() noexcept -> void {
+			journal_.entries_.clear();
+			journal_.applied_ = 0;
+		}
+
+		/* Modifiers
+		 * Each behaves as the graph member of the same name, including what it throws, and
+		 * records a delta when the graph changed.
+		 */
+
+		/* Complexity: That of graph::insert_node().
+		 */
+		auto insert_node(N const& value) -> bool {
+			if (not graph_.insert_node(value)) {
+				return false;
+			}
+			journal_.record(typename journal::insert_node_op{value});
+			return true;
+		}
+
+		/* Complexity: That of graph::insert_edge().
+		 */
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			if (not graph_.insert_edge(src, dst, weight)) {
+				return false;
+			}
+			journal_.record(typename journal::insert_edge_op{value_type{src, dst, weight}});
+			return true;
+		}
+
+		/* Complexity: That of graph::replace_node().
+		 */
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			if (not graph_.replace_node(old_data, new_data)) {
+				return false;
+			}
+			journal_.record(typename journal::replace_node_op{old_data, new_data});
+			return true;
+		}
+
+		/* Complexity: O(d log (e)) on top of graph::merge_replace_node(), where d is the degree of
+		 * old_data.
+		 * The d edges of old_data are recorded, along with which of them become new edges of
+		 * new_data rather than merging into one it already had.
+		 */
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			if (not graph_.is_node(old_data) or not graph_.is_node(new_data)) {
+				graph_.merge_replace_node(old_data, new_data);
+				return;
+			}
+			// Merging a node into itself changes nothing.
+			if (same(old_data, new_data)) {
+				return;
+			}
+			auto op = typename journal::merge_replace_node_op{old_data, new_data, {}, {}};
+			op.edges = incident_edges(old_data);
+			std::for_each(op.edges.begin(), op.edges.end(), [&](value_type const& e) {
+				auto merged = value_type{same(e.from, old_data) ? new_data : e.from,
+				                         same(e.to, old_data) ? new_data : e.to,
+				                         e.weight};
+				if (graph_.find(merged.from, merged.to, merged.weight) == graph_.end()) {
+					op.added.push_back(std::move(merged));
+				}
+			});
+			graph_.merge_replace_node(old_data, new_data);
+			journal_.record(std::move(op));
+		}
+
+		/* Complexity: O(d) on top of graph::erase_node(), where d is the degree of value.
+		 */
+		auto erase_node(N const& value) -> bool {
+			if (not graph_.is_node(value)) {
+				return false;
+			}
+			auto op = typename journal::erase_node_op{value, incident_edges(value)};
+			graph_.erase_node(value);
+			journal_.record(std::move(op));
+			return true;
+		}
+
+		/* Complexity: That of graph::erase_edge().
+		 */
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			if (not graph_.erase_edge(src, dst, weight)) {
+				return false;
+			}
+			journal_.record(typename journal::erase_edge_op{value_type{src, dst, weight}});
+			return true;
+		}
+
+		/* Complexity: O(n + e)
+		 * The whole graph is recorded, as that is what undoing it has to put back.
+		 */
+		auto clear() -> void {
+			if (graph_.empty()) {
+				return;
+			}
+			auto op = typename journal::clear_op{graph_.nodes(), {graph_.begin(), graph_.end()}};
+			graph_.clear();
+			journal_.record(std::move(op));
+		}
+
+		/* History */
+
+		[[nodiscard]] auto can_undo() const noexcept -> bool {
+			return journal_.applied_ > 0;
+		}
+
+		[[nodiscard]] auto can_redo() const noexcept -> bool {
+			return journal_.applied_ < journal_.entries_.size();
+		}
+
+		/* Complexity: About that of the modification being undone.
+		 * Reverts the last applied delta and returns whether there was one.
+		 */
+		auto undo() -> bool {
+			if (not can_undo()) {
+				return false;
+			}
+			revert(journal_.entries_[journal_.applied_ - 1]);
+			--journal_.applied_;
+			return true;
+		}
+
+		/* Complexity: About that of the modification being redone.
+		 * Applies the first undone delta again and returns whether there was one.
+		 */
+		auto redo() -> bool {
+			if (not can_redo()) {
+				return false;
+			}
+			apply(journal_.entries_[journal_.applied_]);
+			++journal_.applied_;
+			return true;
+		}
+
+		/* Complexity: That of making each modification in turn.
+		 * Makes the modifications of every applied delta of other on this graph, in order, each
+		 * recorded in this journal as usual. A modification throws as its graph member would when
+		 * this graph lacks a node it needs, leaving the deltas before it applied.
+		 */
+		auto replay(journal const& other) -> void {
+			if (&other == &journal_) {
+				auto const copy = other;
+				replay(copy);
+				return;
+			}
+			std::for_each_n(other.entries_.begin(), other.applied_, [this](auto const& op) {
+				redo_through_members(op);
+			});
+		}
+
+		friend auto operator<<(std::ostream& os, journaled_graph const& g) -> std::ostream& {
+			return os << g.graph_;
+		}
+
+	private:
+		using operation = typename journal::operation;
+
+		graph_type graph_;
+		journal journal_;
+
+		// Nodes are ordered by <, so that is what decides whether two values are the same node.
+		static auto same(N const& first, N const& second) -> bool {
+			return not(first < second) and not(second < first);
+		}
+
+		// Each self-loop is both outgoing and incoming, and is only listed once.
+		auto incident_edges(N const& value) const -> std::vector<value_type> {
+			auto const out = graph_.edges_from(value);
+			auto edges = std::vector<value_type>(out.begin(), out.end());
+			auto const in = graph_.in_edges(value);
+			std::copy_if(in.begin(), in.end(), std::back_inserter(edges), [&](auto const& e) {
+				return not same(e.from, value);
+			});
+			return edges;
+		}
+
+		/* Applies op to the graph as it was when op was recorded, without recording it again.
+		 */
+		auto apply(operation const& op) -> void {
+			if (auto const* insert = std::get_if<typename journal::insert_node_op>(&op)) {
+				graph_.insert_node(insert->value);
+			}
+			else if (auto const* erase = std::get_if<typename journal::erase_node_op>(&op)) {
+				graph_.erase_node(erase->value);
+			}
+			else if (auto const* replace = std::get_if<typename journal::replace_node_op>(&op)) {
+				graph_.replace_node(replace->old_data, replace->new_data);
+			}
+			else if (auto const* merge = std::get_if<typename journal::merge_replace_node_op>(&op)) {
+				graph_.merge_replace_node(merge->old_data, merge->new_data);
+			}
+			else if (auto const* insert_e = std::get_if<typename journal::insert_edge_op>(&op)) {
+				graph_.insert_edge(insert_e->edge.from, insert_e->edge.to, insert_e->edge.weight);
+			}
+			else if (auto const* erase_e = std::get_if<typename journal::erase_edge_op>(&op)) {
+				graph_.erase_edge(erase_e->edge.from, erase_e->edge.to, erase_e->edge.weight);
+			}
+			else {
+				graph_.clear();
+			}
+		}
+
+		/* Reverses op on the graph as it was right after op was made.
+		 */
+		auto revert(operation const& op) -> void {
+			if (auto const* insert = std::get_if<typename journal::insert_node_op>(&op)) {
+				graph_.erase_node(insert->value);
+			}
+			else if (auto const* erase = std::get_if<typename journal::erase_node_op>(&op)) {
+				graph_.insert_node(erase->value);
+				graph_.insert_edges(erase->edges.begin(), erase->edges.end());
+			}
+			else if (auto const* replace = std::get_if<typename journal::replace_node_op>(&op)) {
+				graph_.replace_node(replace->new_data, replace->old_data);
+			}
+			else if (auto const* merge = std::get_if<typename journal::merge_replace_node_op>(&op)) {
+				graph_.insert_node(merge->old_data);
+				graph_.erase_edges(merge->added.begin(), merge->added.end());
+				graph_.insert_edges(merge->edges.begin(), merge->edges.end());
+			}
+			else if (auto const* insert_e = std::get_if<typename journal::insert_edge_op>(&op)) {
+				graph_.erase_edge(insert_e->edge.from, insert_e->edge.to, insert_e->edge.weight);
+			}
+			else if (auto const* erase_e = std::get_if<typename journal::erase_edge_op>(&op)) {
+				graph_.insert_edge(erase_e->edge.from, erase_e->edge.to, erase_e->edge.weight);
+			}
+			else {
+				auto const& cleared = std::get<typename journal::clear_op>(op);
+				graph_.insert_nodes(cleared.nodes.begin(), cleared.nodes.end());
+				graph_.insert_edges(sorted_unique, cleared.edges.begin(), cleared.edges.end());
+			}
+		}
+
+		/* Makes the modification op describes through the members above, so that it is checked
+		 * against this graph and recorded like any other.
+		 */
+		auto redo_through_members(operation const& op) -> void {
+			if (auto const* insert = std::get_if<typename journal::insert_node_op>(&op)) {
+				insert_node(insert->value);
+			}
+			else if (auto const* erase = std::get_if<typename journal::erase_node_op>(&op)) {
+				erase_node(erase->value);
+			}
+			else if (auto const* replace = std::get_if<typename journal::replace_node_op>(&op)) {
+				replace_node(replace->old_data, replace->new_data);
+			}
+			else if (auto const* merge = std::get_if<typename journal::merge_replace_node_op>(&op)) {
+				merge_replace_node(merge->old_data, merge->new_data);
+			}
+			else if (auto const* insert_e = std::get_if<typename journal::insert_edge_op>(&op)) {
+				insert_edge(insert_e->edge.from, insert_e->edge.to, insert_e->edge.weight);
+			}
+			else if (auto const* erase_e = std::get_if<typename journal::erase_edge_op>(&op)) {
+				erase_edge(erase_e->edge.from, erase_e->edge.to, erase_e->edge.weight);
+			}
+			else {
+				clear();
+			}
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_JOURNALED_GRAPH_HPP
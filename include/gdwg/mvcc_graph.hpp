@@ -0,0 +1,159 @@
+#ifndef GDWG_MVCC_GRAPH_HPP
+#define GDWG_MVCC_GRAPH_HPP
+
+#include "gdwg/persistent_graph.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace gdwg {
+	/* A graph that one writer thread modifies while any number of reader threads read consistent
+	 * snapshots of it, without readers ever taking a lock.
+	 *
+	 * Every state of the graph is an immutable persistent_graph<N, E> version. Each write builds
+	 * the next version, which shares all but O(log (n)) of its structure with the previous one,
+	 * and publishes it by swapping a plain atomic pointer. snapshot() copies the version that
+	 * pointer is at, which only copies a reference to its tree, and a reader keeps using the copy
+	 * for as long as it likes, unaffected by later writes.
+	 *
+	 * Published versions are reclaimed by epochs. A reader counts itself in under the epoch it
+	 * started in for the moment it takes to copy a version, and the writer frees the version it
+	 * replaced once every reader of the epoch before its swap has left. A reader only ever retries,
+	 * when a write ends that epoch just as it starts. The writer is the one that waits, for at most
+	 * as long as the readers already copying take.
+	 *
+	 * snapshot() may be called from any thread. The modifiers must all be called from one writer
+	 * thread at a time.
+	 */
+	template<typename N, typename E>
+	class mvcc_graph {
+	public:
+		using version_type = persistent_graph<N, E>;
+
+		mvcc_graph()
+		: mvcc_graph(version_type()) {}
+
+		mvcc_graph(std::initializer_list<N> il)
+		: mvcc_graph(version_type(il)) {}
+
+		explicit mvcc_graph(version_type initial)
+		: latest_(std::make_unique<version_type const>(std::move(initial)))
+		, current_(latest_.get()) {}
+
+		mvcc_graph(mvcc_graph const&) = delete;
+		auto operator=(mvcc_graph const&) -> mvcc_graph& = delete;
+
+		/* Complexity: Constant time.
+		 * The latest published version. It never changes, whatever the writer does afterwards.
+		 */
+		[[nodiscard]] auto snapshot() const -> version_type {
+			auto const parity = enter();
+			auto snapshot = *current_.load(std::memory_order_acquire);
+			readers_[parity].fetch_sub(1, std::memory_order_release);
+			return snapshot;
+		}
+
+		/* Writer */
+
+		/* Complexity: O(log (n))
+		 */
+		auto insert_node(N const& value) -> bool {
+			auto const current = latest();
+			if (current.is_node(value)) {
+				return false;
+			}
+			publish(current.insert_node(value));
+			return true;
+		}
+
+		/* Complexity: O(log (n) + log (d)), where d is the degree of src or dst.
+		 */
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const current = latest();
+			if (current.is_node(src) and current.find(src, dst, weight) not_eq current.end()) {
+				return false;
+			}
+			publish(current.insert_edge(src, dst, weight));
+			return true;
+		}
+
+		/* Complexity: O(log (n) + log (d)), where d is the degree of src or dst.
+		 */
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto const current = latest();
+			// Throws for a missing node, and is current itself when there is no such edge.
+			auto const next = current.erase_edge(src, dst, weight);
+			if (current.find(src, dst, weight) == current.end()) {
+				return false;
+			}
+			publish(next);
+			return true;
+		}
+
+		/* Complexity: O(d (log (n) + log (d))), where d is the degree of value.
+		 */
+		auto erase_node(N const& value) -> bool {
+			auto const current = latest();
+			if (not current.is_node(value)) {
+				return false;
+			}
+			publish(current.erase_node(value));
+			return true;
+		}
+
+		/* Applies several modifications as one. f is given the latest version and returns the
+		 * next one, which readers then see all at once. Nothing is published if f throws.
+		 */
+		template<typename F>
+		auto update(F f) -> void {
+			publish(f(latest()));
+		}
+
+	private:
+		// Owned by the writer, which is the only one to replace it.
+		std::unique_ptr<version_type const> latest_;
+		std::atomic<version_type const*> current_;
+		std::atomic<std::uint64_t> epoch_ = 0;
+		// The readers still copying a version, counted under the parity of the epoch they began in.
+		mutable std::array<std::atomic<std::size_t>, 2> readers_ = {};
+
+		[[nodiscard]] auto latest() const -> version_type {
+			return *latest_;
+		}
+
+		/* Counts the calling reader in under the current epoch and returns its parity. If a write
+		 * ends that epoch in between, the writer may not have seen the count, so it is moved over.
+		 */
+		auto enter() const -> std::size_t {
+			auto epoch = epoch_.load();
+			readers_[epoch % 2].fetch_add(1);
+			while (epoch_.load() not_eq epoch) {
+				readers_[epoch % 2].fetch_sub(1);
+				epoch = epoch_.load();
+				readers_[epoch % 2].fetch_add(1);
+			}
+			return static_cast<std::size_t>(epoch % 2);
+		}
+
+		/* Readers that start after the swap see only next. Those of the epoch it ends may still
+		 * be copying the previous version, which is freed once they have all left.
+		 */
+		auto publish(version_type next) -> void {
+			auto fresh = std::make_unique<version_type const>(std::move(next));
+			current_.store(fresh.get());
+			auto const epoch = epoch_.fetch_add(1);
+			while (readers_[epoch % 2].load() not_eq 0) {
+				std::this_thread::yield();
+			}
+			latest_ = std::move(fresh);
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_MVCC_GRAPH_HPP
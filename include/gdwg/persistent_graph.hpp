@@ -0,0 +1,575 @@
+#ifndef GDWG_PERSISTENT_GRAPH_HPP
+#define GDWG_PERSISTENT_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	/* An immutable directed weighted graph. Every modifier leaves the graph it is called on alone
+	 * and returns the modified graph as a new version instead.
+	 *
+	 * A version is a treap of nodes, and each node holds a treap of its outgoing (dst, weight)
+	 * pairs and one of its incoming (src, weight) pairs. Treap nodes are never changed once built,
+	 * so a modifier copies only the O(log (n)) nodes on the path to what it changes and shares
+	 * everything else with the version it started from. Keeping many versions therefore costs
+	 * little more than the changes between them, and copying a version is constant time.
+	 */
+	template<typename N, typename E>
+	class persistent_graph {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+
+		persistent_graph() noexcept = default;
+
+		persistent_graph(std::initializer_list<N> il)
+		: persistent_graph(il.begin(), il.end()) {}
+
+		template<typename InputIt>
+		persistent_graph(InputIt first, InputIt last) {
+			std::for_each(first, last, [this](N const& value) { *this = insert_node(value); });
+		}
+
+		/* Complexity: O((n + e) log (n))
+		 */
+		template<typename Allocator>
+		explicit persistent_graph(graph<N, E, Allocator> const& g) {
+			auto const nodes = g.nodes();
+			*this = persistent_graph(nodes.begin(), nodes.end());
+			std::for_each(g.begin(), g.end(), [this](auto const& e) {
+				*this = insert_edge(e.from, e.to, e.weight);
+			});
+		}
+
+		class iterator;
+
+		/* Modifiers */
+
+		/* Complexity: O(log (n))
+		 * Returns this version itself if value is already a node.
+		 */
+		[[nodiscard]] auto insert_node(N const& value) const -> persistent_graph {
+			if (nodes_.find(value) not_eq nullptr) {
+				return *this;
+			}
+			return persistent_graph(nodes_.insert(value, adjacency{}));
+		}
+
+		/* Complexity: O(log (n) + log (d)), where d is the degree of src or dst.
+		 * Returns this version itself if the edge is already there.
+		 */
+		[[nodiscard]] auto insert_edge(N const& src, N const& dst, E const& weight) const
+		   -> persistent_graph {
+			auto const* const error_msg = "Cannot call gdwg::persistent_graph<N, E>::insert_edge when"
+			                              " either src or dst node does not exist";
+			auto const [from, to] = locate(src, dst, error_msg);
+			if (from->value.out.find({dst, weight}) not_eq nullptr) {
+				return *this;
+			}
+			auto const& source = from->value;
+			if (from == to) {
+				// A self-loop is both an outgoing and an incoming edge of the one node.
+				auto self = adjacency{source.out.insert({dst, weight}),
+				                      source.in.insert({src, weight})};
+				return persistent_graph(nodes_.insert(src, std::move(self)));
+			}
+			auto const& target = to->value;
+			auto const nodes = nodes_.insert(src, {source.out.insert({dst, weight}), source.in});
+			return persistent_graph(nodes.insert(dst, {target.out, target.in.insert({src, weight})}));
+		}
+
+		/* Complexity: O(log (n) + log (d)), where d is the degree of src or dst.
+		 * Returns this version itself if there is no such edge.
+		 */
+		[[nodiscard]] auto erase_edge(N const& src, N const& dst, E const& weight) const
+		   -> persistent_graph {
+			auto const* const error_msg = "Cannot call gdwg::persistent_graph<N, E>::erase_edge on"
+			                              " src or dst if they don't exist in the graph";
+			auto const [from, to] = locate(src, dst, error_msg);
+			if (from->value.out.find({dst, weight}) == nullptr) {
+				return *this;
+			}
+			auto const& source = from->value;
+			if (from == to) {
+				// A self-loop is both an outgoing and an incoming edge of the one node.
+				auto self = adjacency{source.out.erase({dst, weight}),
+				                      source.in.erase({src, weight})};
+				return persistent_graph(nodes_.insert(src, std::move(self)));
+			}
+			auto const& target = to->value;
+			auto const nodes = nodes_.insert(src, {source.out.erase({dst, weight}), source.in});
+			return persistent_graph(nodes.insert(dst, {target.out, target.in.erase({src, weight})}));
+		}
+
+		/* Complexity: O(d (log (n) + log (d))), where d is the degree of value.
+		 * Only the d nodes at the other end of an edge of value are copied. Returns this version
+		 * itself if value is not a node.
+		 */
+		[[nodiscard]] auto erase_node(N const& value) const -> persistent_graph {
+			auto const* const node = nodes_.find(value);
+			if (node == nullptr) {
+				return *this;
+			}
+			auto nodes = nodes_;
+			for_each_key(node->value.in, [&](auto const& in) {
+				auto const& [src, weight] = in;
+				if (src < value or value < src) {
+					nodes = nodes.update(src, [&](adjacency const& source) {
+						return adjacency{source.out.erase({value, weight}), source.in};
+					});
+				}
+			});
+			for_each_key(node->value.out, [&](auto const& out) {
+				auto const& [dst, weight] = out;
+				if (dst < value or value < dst) {
+					nodes = nodes.update(dst, [&](adjacency const& target) {
+						return adjacency{target.out, target.in.erase({value, weight})};
+					});
+				}
+			});
+			return persistent_graph(nodes.erase(value));
+		}
+
+		/* Accessors */
+
+		/* Complexity: O(log (n))
+		 */
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return nodes_.find(value) not_eq nullptr;
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.root() == nullptr;
+		}
+
+		/* Complexity: O(log (n) + log (d)), where d is the out-degree of src.
+		 */
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto const* const error_msg = "Cannot call gdwg::persistent_graph<N, E>::is_connected if"
+			                              " src or dst node don't exist in the graph";
+			auto const [from, to] = locate(src, dst, error_msg);
+			auto const first = edges_to(from->value.out, dst);
+			return first.get() not_eq nullptr and not(dst < first.get()->key.first);
+		}
+
+		/* Complexity: O(n)
+		 */
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto nodes = std::vector<N>{};
+			for_each_key(nodes_, [&nodes](N const& value) { nodes.push_back(value); });
+			return nodes;
+		}
+
+		/* Complexity: O(log (n) + log (d) + w), where d is the out-degree of src and w is the
+		 * number of returned weights.
+		 */
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto const* const error_msg = "Cannot call gdwg::persistent_graph<N, E>::weights if src"
+			                              " or dst node don't exist in the graph";
+			auto const [from, to] = locate(src, dst, error_msg);
+			auto weights = std::vector<E>{};
+			for (auto c = edges_to(from->value.out, dst); c.get() not_eq nullptr; c.next()) {
+				if (dst < c.current().key.first) {
+					break;
+				}
+				weights.push_back(c.current().key.second);
+			}
+			return weights;
+		}
+
+		/* Complexity: O(log (n) + d), where d is the out-degree of src.
+		 */
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const* const error_msg = "Cannot call gdwg::persistent_graph<N, E>::connections if"
+			                              " src doesn't exist in the graph";
+			auto const* const from = nodes_.find(src);
+			if (from == nullptr) {
+				throw std::runtime_error(error_msg);
+			}
+			auto connections = std::vector<N>{};
+			for_each_key(from->value.out, [&](auto const& out) { connections.push_back(out.first); });
+			return connections;
+		}
+
+		/* Complexity: O(log (n) + log (d)), where d is the out-degree of src.
+		 */
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const nodes = node_cursor(nodes_.root(), [&src](N const& key) { return key < src; });
+			auto const* const from = nodes.get();
+			if (from == nullptr or src < from->key) {
+				return end();
+			}
+			auto const target = std::pair<N, E>(dst, weight);
+			auto const edges = edge_cursor(from->value.out.root(), [&target](auto const& key) {
+				return key < target;
+			});
+			auto const* const edge = edges.get();
+			if (edge == nullptr or dst < edge->key.first or weight < edge->key.second) {
+				return end();
+			}
+			return iterator(nodes, edges);
+		}
+
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(node_cursor(nodes_.root()));
+		}
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator();
+		}
+
+		/* Complexity: Constant time for two versions that share every node, otherwise O(n + e).
+		 */
+		[[nodiscard]] auto operator==(persistent_graph const& other) const -> bool {
+			if (nodes_.root() == other.nodes_.root()) {
+				return true;
+			}
+			auto const same = [](value_type const& a, value_type const& b) {
+				return not(a.from < b.from or b.from < a.from or a.to < b.to or b.to < a.to
+				           or a.weight < b.weight or b.weight < a.weight);
+			};
+			return nodes() == other.nodes()
+			       and std::equal(begin(), end(), other.begin(), other.end(), same);
+		}
+
+		friend auto operator<<(std::ostream& os, persistent_graph const& g) -> std::ostream& {
+			for (auto c = node_cursor(g.nodes_.root()); c.get() not_eq nullptr; c.next()) {
+				os << c.current().key << " (\n";
+				for_each_key(c.current().value.out, [&os](auto const& out) {
+					os << "  " << out.first << " | " << out.second << "\n";
+				});
+				os << ")\n";
+			}
+			return os;
+		}
+
+	private:
+		/* A treap that is never modified in place. insert() and erase() return a new treap that
+		 * shares every node off the path they change with this one.
+		 */
+		template<typename Key, typename Value>
+		class tree {
+		public:
+			struct node;
+			using node_ptr = std::shared_ptr<node const>;
+
+			struct node {
+				Key key;
+				Value value;
+				std::uint64_t priority;
+				node_ptr left;
+				node_ptr right;
+			};
+
+			/* Complexity: Expected O(log (n))
+			 */
+			[[nodiscard]] auto find(Key const& key) const -> node const* {
+				auto const* n = root_.get();
+				while (n not_eq nullptr and (key < n->key or n->key < key)) {
+					n = key < n->key ? n->left.get() : n->right.get();
+				}
+				return n;
+			}
+			/* Complexity: Expected O(log (n))
+			 * Replaces the value of key if it is already there.
+			 */
+			[[nodiscard]] auto insert(Key const& key, Value value = Value()) const -> tree {
+				return tree(insert(root_, key, std::move(value)));
+			}
+
+			/* Complexity: Expected O(log (n))
+			 * Replaces the value of key, if it is there, with f of it. The shape of the tree stays
+			 * the same, so only the path to key is copied.
+			 */
+			template<typename F>
+			[[nodiscard]] auto update(Key const& key, F f) const -> tree {
+				return tree(update(root_, key, f));
+			}
+
+			/* Complexity: Expected O(log (n))
+			 */
+			[[nodiscard]] auto erase(Key const& key) const -> tree {
+				return tree(erase(root_, key));
+			}
+
+			[[nodiscard]] auto root() const noexcept -> node const* {
+				return root_.get();
+			}
+
+			tree() noexcept = default;
+
+		private:
+			node_ptr root_;
+
+			explicit tree(node_ptr root) noexcept
+			: root_(std::move(root)) {}
+
+			friend class persistent_graph;
+
+			static auto make(Key key,
+			                 Value value,
+			                 std::uint64_t priority,
+			                 node_ptr left,
+			                 node_ptr right) -> node_ptr {
+				return std::make_shared<node const>(
+				   node{std::move(key), std::move(value), priority, std::move(left), std::move(right)});
+			}
+
+			// A fresh node that rises above its parent is rotated up in the parent's copy.
+			static auto insert(node_ptr const& t, Key const& key, Value&& value) -> node_ptr {
+				if (t == nullptr) {
+					return make(key, std::move(value), next_priority(), nullptr, nullptr);
+				}
+				if (key < t->key) {
+					auto const left = insert(t->left, key, std::move(value));
+					if (left->priority > t->priority) {
+						auto right = make(t->key, t->value, t->priority, left->right, t->right);
+						return make(left->key, left->value, left->priority, left->left, std::move(right));
+					}
+					return make(t->key, t->value, t->priority, left, t->right);
+				}
+				if (t->key < key) {
+					auto const right = insert(t->right, key, std::move(value));
+					if (right->priority > t->priority) {
+						auto left = make(t->key, t->value, t->priority, t->left, right->left);
+						return make(right->key,
+						            right->value,
+						            right->priority,
+						            std::move(left),
+						            right->right);
+					}
+					return make(t->key, t->value, t->priority, t->left, right);
+				}
+				return make(t->key, std::move(value), t->priority, t->left, t->right);
+			}
+
+			template<typename F>
+			static auto update(node_ptr const& t, Key const& key, F& f) -> node_ptr {
+				if (t == nullptr) {
+					return t;
+				}
+				if (key < t->key) {
+					return make(t->key, t->value, t->priority, update(t->left, key, f), t->right);
+				}
+				if (t->key < key) {
+					return make(t->key, t->value, t->priority, t->left, update(t->right, key, f));
+				}
+				return make(t->key, f(t->value), t->priority, t->left, t->right);
+			}
+
+			// Returns t itself when key isn't in it, so nothing is copied.
+			static auto erase(node_ptr const& t, Key const& key) -> node_ptr {
+				if (t == nullptr) {
+					return t;
+				}
+				if (key < t->key) {
+					auto left = erase(t->left, key);
+					if (left == t->left) {
+						return t;
+					}
+					return make(t->key, t->value, t->priority, std::move(left), t->right);
+				}
+				if (t->key < key) {
+					auto right = erase(t->right, key);
+					if (right == t->right) {
+						return t;
+					}
+					return make(t->key, t->value, t->priority, t->left, std::move(right));
+				}
+				return join(t->left, t->right);
+			}
+
+			static auto join(node_ptr const& first, node_ptr const& second) -> node_ptr {
+				if (first == nullptr) {
+					return second;
+				}
+				if (second == nullptr) {
+					return first;
+				}
+				if (first->priority > second->priority) {
+					return make(first->key,
+					            first->value,
+					            first->priority,
+					            first->left,
+					            join(first->right, second));
+				}
+				return make(second->key,
+				            second->value,
+				            second->priority,
+				            join(first, second->left),
+				            second->right);
+			}
+		};
+
+		/* In-order traversal of a tree, starting from the first key for which before() is false.
+		 * The stack holds the nodes still to be visited whose right subtrees haven't been entered.
+		 */
+		template<typename Node>
+		class cursor {
+		public:
+			cursor() = default;
+
+			explicit cursor(Node const* root)
+			: cursor(root, [](auto const&) { return false; }) {}
+
+			template<typename Before>
+			cursor(Node const* root, Before before) {
+				while (root not_eq nullptr) {
+					if (before(root->key)) {
+						root = root->right.get();
+					}
+					else {
+						stack_.push_back(root);
+						root = root->left.get();
+					}
+				}
+			}
+
+			[[nodiscard]] auto get() const -> Node const* {
+				return stack_.empty() ? nullptr : stack_.back();
+			}
+
+			// The node the cursor is at, which there must be.
+			[[nodiscard]] auto current() const -> Node const& {
+				return *stack_.back();
+			}
+
+			auto next() -> void {
+				auto const* n = stack_.back()->right.get();
+				stack_.pop_back();
+				for (; n not_eq nullptr; n = n->left.get()) {
+					stack_.push_back(n);
+				}
+			}
+
+		private:
+			std::vector<Node const*> stack_;
+		};
+
+		struct no_value {};
+
+		// out holds (dst, weight) for the outgoing edges, in holds (src, weight) for the incoming.
+		using edge_tree = tree<std::pair<N, E>, no_value>;
+		struct adjacency {
+			edge_tree out;
+			edge_tree in;
+		};
+		using node_tree = tree<N, adjacency>;
+
+		using node_cursor = cursor<typename node_tree::node>;
+		using edge_cursor = cursor<typename edge_tree::node>;
+
+		node_tree nodes_;
+
+		explicit persistent_graph(node_tree nodes) noexcept
+		: nodes_(std::move(nodes)) {}
+
+		/* Priorities only need to look random. A shared counter keeps them unique and spreads them
+		 * out with the SplitMix64 finaliser.
+		 */
+		static auto next_priority() noexcept -> std::uint64_t {
+			static auto counter = std::atomic<std::uint64_t>{0};
+			auto z = counter.fetch_add(0x9e3779b97f4a7c15, std::memory_order_relaxed);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			return z ^ (z >> 31);
+		}
+
+		template<typename Tree, typename F>
+		static auto for_each_key(Tree const& t, F f) -> void {
+			for (auto c = cursor<typename Tree::node>(t.root()); c.get() not_eq nullptr; c.next()) {
+				f(c.current().key);
+			}
+		}
+
+		/* The first outgoing edge of a node that goes to dst or a later node.
+		 */
+		static auto edges_to(edge_tree const& out, N const& dst) -> edge_cursor {
+			return edge_cursor(out.root(), [&dst](auto const& key) { return key.first < dst; });
+		}
+
+		auto locate(N const& src, N const& dst, char const* error_msg) const
+		   -> std::pair<typename node_tree::node const*, typename node_tree::node const*> {
+			auto const* const from = nodes_.find(src);
+			auto const* const to = nodes_.find(dst);
+			if (from == nullptr or to == nullptr) {
+				throw std::runtime_error(error_msg);
+			}
+			return {from, to};
+		}
+
+	public:
+		/* Visits every edge in order of source, destination and weight. An iterator is valid for
+		 * as long as the version it came from.
+		 */
+		class iterator {
+		public:
+			using value_type = persistent_graph::value_type;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				auto const& edge = edges_.current().key;
+				return value_type{nodes_.current().key, edge.first, edge.second};
+			}
+
+			auto operator++() -> iterator& {
+				edges_.next();
+				skip_empty_nodes();
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				return nodes_.get() == other.nodes_.get() and edges_.get() == other.edges_.get();
+			}
+
+		private:
+			node_cursor nodes_;
+			edge_cursor edges_;
+
+			friend class persistent_graph;
+
+			explicit iterator(node_cursor nodes)
+			: nodes_(std::move(nodes))
+			, edges_(nodes_.get() == nullptr ? edge_cursor() : edge_cursor(out_root())) {
+				skip_empty_nodes();
+			}
+
+			iterator(node_cursor nodes, edge_cursor edges)
+			: nodes_(std::move(nodes))
+			, edges_(std::move(edges)) {}
+
+			[[nodiscard]] auto out_root() const -> typename edge_tree::node const* {
+				return nodes_.current().value.out.root();
+			}
+
+			auto skip_empty_nodes() -> void {
+				while (nodes_.get() not_eq nullptr and edges_.get() == nullptr) {
+					nodes_.next();
+					if (nodes_.get() not_eq nullptr) {
+						edges_ = edge_cursor(out_root());
+					}
+				}
+			}
+		};
+	};
+} // namespace gdwg
+
+#endif // GDWG_PERSISTENT_GRAPH_HPP
@@ -0,0 +1,15 @@
+#ifndef GDWG_SORTED_UNIQUE_HPP
+#define GDWG_SORTED_UNIQUE_HPP
+
+namespace gdwg {
+	/* Passed to insert_edges() to promise that the edges already come sorted by (from, to, weight)
+	 * with no repeats, so that they can be placed one after another instead of being searched for.
+	 */
+	struct sorted_unique_t {
+		explicit sorted_unique_t() = default;
+	};
+
+	inline constexpr auto sorted_unique = sorted_unique_t{};
+} // namespace gdwg
+
+#endif // GDWG_SORTED_UNIQUE_HPP
@@ -10,13 +10,33 @@
     * 5. Test weights() that get see all weights.
     * 6. Test find() that find a edge.
     * 7. Test connections() that get all edges connected to a node.
-    * 8. Test exception.
+    * 8. Test predecessors() that get all nodes connected to a node.
+    * 9. Test in_edges() that get all edges coming into a node.
+    * 10. Test edges_between() that get all edges from one node to another.
+    * 11. Test edges_from() that get all edges leaving a node.
+    * 12. Test connections() stays up to date after modifiers.
+    * 13. Test is_node() stays up to date after modifiers.
+    * 14. Test accessors of a node type that has no std::hash.
+    * 15. Test try_ accessors that don't throw.
+    * 16. Test exception.
  */
 
 #include "gdwg/graph.hpp"
 
 #include <catch2/catch.hpp>
 
+namespace {
+	// A node type that std::hash knows nothing about, so lookups go through the ordered node set.
+	struct point {
+		int x;
+		int y;
+		auto operator<=>(point const&) const = default;
+	};
+} // namespace
+
+static_assert(gdwg::enable_hashed_node_index<std::string>);
+static_assert(not gdwg::enable_hashed_node_index<point>);
+
 TEST_CASE("is_node()", "[gdwg.accessors]") {
 	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
 	CHECK(g.is_node("wang"));
@@ -87,12 +107,181 @@ TEST_CASE("connections()", "[gdwg.accessors]") {
 	CHECK(connections == expected_connections);
 }
 
+TEST_CASE("predecessors()", "[gdwg.accessors]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("shi", "liao", 2);
+	g.insert_edge("chen", "liao", 3);
+	g.insert_edge("liao", "liao", 4);
+	g.insert_edge("liao", "fan", 5);
+	auto expected_predecessors = std::vector<std::string>{"chen", "liao", "shi", "wang"};
+	CHECK(g.predecessors("liao") == expected_predecessors);
+	CHECK(g.predecessors("wang").empty());
+}
+
+TEST_CASE("in_edges()", "[gdwg.accessors]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+	g.insert_edge("wang", "liao", 2);
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("shi", "liao", 3);
+	g.insert_edge("liao", "fan", 4);
+	auto const in_edges = g.in_edges("liao");
+	REQUIRE(in_edges.size() == 3);
+	CHECK(in_edges[0].from == "shi");
+	CHECK(in_edges[0].weight == 3);
+	CHECK(in_edges[1].from == "wang");
+	CHECK(in_edges[1].weight == 1);
+	CHECK(in_edges[2].from == "wang");
+	CHECK(in_edges[2].weight == 2);
+
+	SECTION("after erase_node() of a source") {
+		g.erase_node("wang");
+		auto const remaining = g.in_edges("liao");
+		REQUIRE(remaining.size() == 1);
+		CHECK(remaining[0].from == "shi");
+	}
+
+	SECTION("after merge_replace_node() of a source") {
+		g.merge_replace_node("wang", "shi");
+		auto expected_predecessors = std::vector<std::string>{"shi", "shi", "shi"};
+		CHECK(g.predecessors("liao") == expected_predecessors);
+	}
+}
+
+TEST_CASE("edges_between()", "[gdwg.accessors]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 3);
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "fan", 2);
+	g.insert_edge("wang", "shi", 4);
+	g.insert_edge("liao", "liao", 5);
+
+	auto const edges = g.edges_between("wang", "liao");
+	static_assert(std::ranges::bidirectional_range<decltype(edges)>);
+	REQUIRE(std::ranges::distance(edges) == 2);
+	CHECK((*edges.begin()).weight == 1);
+	CHECK((*std::next(edges.begin())).weight == 3);
+	CHECK(edges.begin() == g.find("wang", "liao", 1));
+	CHECK(edges.end() == g.find("wang", "shi", 4));
+	CHECK(g.edges_between("liao", "wang").empty());
+	CHECK(g.edges_between("shi", "shi").empty());
+}
+
+TEST_CASE("edges_from()", "[gdwg.accessors]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "fan", 2);
+	g.insert_edge("liao", "wang", 3);
+	g.insert_edge("shi", "shi", 4);
+
+	auto expected = std::vector<std::string>{};
+	for (auto const& [from, to, weight] : g.edges_from("wang")) {
+		CHECK(from == "wang");
+		expected.push_back(to);
+	}
+	CHECK(expected == g.connections("wang"));
+	CHECK(std::ranges::distance(g.edges_from("liao")) == 1);
+	CHECK(g.edges_from("fan").empty());
+	CHECK(g.edges_from("shi").begin() == g.find("shi", "shi", 4));
+}
+
+TEST_CASE("connections() after modifiers", "[gdwg.accessors]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("fan", "wang", 3);
+	g.insert_edge("chen", "fan", 4);
+
+	SECTION("insert_edge() before the first connection") {
+		g.insert_edge("wang", "chen", 5);
+		auto expected_connections = std::vector<std::string>{"chen", "liao", "shi"};
+		CHECK(g.connections("wang") == expected_connections);
+	}
+
+	SECTION("erase_edge() of the first connection") {
+		g.erase_edge("wang", "liao", 1);
+		auto expected_connections = std::vector<std::string>{"shi"};
+		CHECK(g.connections("wang") == expected_connections);
+	}
+
+	SECTION("erase_node() of a destination") {
+		g.erase_node("wang");
+		CHECK(g.connections("fan").empty());
+		auto expected_connections = std::vector<std::string>{"fan"};
+		CHECK(g.connections("chen") == expected_connections);
+	}
+
+	SECTION("merge_replace_node() moves outgoing edges") {
+		g.merge_replace_node("wang", "chen");
+		auto expected_connections = std::vector<std::string>{"fan", "liao", "shi"};
+		CHECK(g.connections("chen") == expected_connections);
+		expected_connections = std::vector<std::string>{"chen"};
+		CHECK(g.connections("fan") == expected_connections);
+	}
+}
+
+TEST_CASE("is_node() after modifiers", "[gdwg.accessors]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("shi", "wang", 2);
+
+	CHECK(g.replace_node("wang", "fan"));
+	CHECK_FALSE(g.is_node("wang"));
+	CHECK(g.is_node("fan"));
+	CHECK(g.is_connected("shi", "fan"));
+
+	g.merge_replace_node("fan", "liao");
+	CHECK_FALSE(g.is_node("fan"));
+	CHECK(g.weights("liao", "liao") == std::vector<int>{1});
+
+	CHECK(g.erase_node("shi"));
+	CHECK_FALSE(g.is_node("shi"));
+	CHECK(g.insert_node("shi"));
+	CHECK(g.connections("shi").empty());
+
+	auto const copy = g;
+	g.clear();
+	CHECK_FALSE(g.is_node("liao"));
+	CHECK(copy.is_node("liao"));
+	CHECK(copy.is_connected("liao", "liao"));
+}
+
+TEST_CASE("accessors without std::hash", "[gdwg.accessors]") {
+	auto g = gdwg::graph<point, int>{{0, 0}, {0, 1}, {1, 0}};
+	CHECK(g.is_node({0, 1}));
+	CHECK_FALSE(g.is_node({1, 1}));
+	CHECK(g.insert_edge({0, 0}, {1, 0}, 3));
+	CHECK(g.is_connected({0, 0}, {1, 0}));
+	CHECK(g.weights({0, 0}, {1, 0}) == std::vector<int>{3});
+	CHECK(g.find({0, 0}, {1, 0}, 3) == g.begin());
+	CHECK(g.erase_node({1, 0}));
+	CHECK(g.connections({0, 0}).empty());
+}
+
+TEST_CASE("try_ accessors", "[gdwg.accessors]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	g.insert_edge("wang", "liao", 2);
+	g.insert_edge("wang", "liao", 1);
+
+	CHECK(g.try_is_connected("wang", "liao") == true);
+	CHECK(g.try_is_connected("liao", "wang") == false);
+	CHECK_FALSE(g.try_is_connected("wang", "fan").has_value());
+	CHECK(g.try_weights("wang", "liao") == std::vector<int>{1, 2});
+	CHECK(g.try_weights("shi", "liao") == std::vector<int>{});
+	CHECK_FALSE(g.try_weights("fan", "liao").has_value());
+	CHECK(g.try_connections("wang") == std::vector<std::string>{"liao", "liao"});
+	CHECK_FALSE(g.try_connections("fan").has_value());
+}
+
 TEST_CASE("exception", "[gdwg.accessors]") {
 	SECTION("is_connected()") {
 		auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
 		CHECK_THROWS_AS(g.is_connected("", "liao"), std::runtime_error);
 		CHECK_THROWS_AS(g.is_connected("wang", ""), std::runtime_error);
 		CHECK_THROWS_AS(g.is_connected("", ""), std::runtime_error);
+		CHECK_THROWS_WITH(g.is_connected("", "liao"),
+		                  "Cannot call gdwg::graph<N, E>::is_connected if src or dst node don't exist "
+		                  "in the graph");
 	}
 
 	SECTION("weights()") {
@@ -107,4 +296,25 @@ TEST_CASE("exception", "[gdwg.accessors]") {
 		CHECK_THROWS_AS(g.connections(""), std::runtime_error);
 		CHECK_THROWS_AS(g.connections("non-exist"), std::runtime_error);
 	}
+
+	SECTION("predecessors()") {
+		auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+		CHECK_THROWS_AS(g.predecessors(""), std::runtime_error);
+	}
+
+	SECTION("in_edges()") {
+		auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+		CHECK_THROWS_AS(g.in_edges(""), std::runtime_error);
+	}
+
+	SECTION("edges_between()") {
+		auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+		CHECK_THROWS_AS(g.edges_between("", "liao"), std::runtime_error);
+		CHECK_THROWS_AS(g.edges_between("wang", ""), std::runtime_error);
+	}
+
+	SECTION("edges_from()") {
+		auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+		CHECK_THROWS_AS(g.edges_from(""), std::runtime_error);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,243 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.constructors & gdwg.modifiers to check that gdwg::pmr::graph takes
+              every allocation it makes from the memory resource it was given.
+ * @approach:
+    * 1. Test building a graph inside a monotonic arena.
+    * 2. Test get_allocator() and allocator-extended copy.
+    * 3. Test move construction keeps the allocator.
+    * 4. Test move assignment between different memory resources.
+    * 5. Test copy assignment keeps the allocator of the target.
+    * 6. Test how many allocations an edge costs.
+    * 7. Test merge_replace_node() allocates nothing.
+    * 8. Test rejected inserts allocate nothing.
+    * 9. Test inserting nodes after reserve() only allocates the nodes themselves.
+    * 10. Test re-inserting erased edges reuses their tombstones.
+ */
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory_resource>
+
+namespace {
+	// Forwards to the new/delete resource and counts how many allocations are still live.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		std::size_t live = 0;
+		std::size_t total = 0;
+
+	private:
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++live;
+			++total;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			--live;
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+		auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+			return this == &other;
+		}
+	};
+
+	// Any allocation that falls back to the default resource throws std::bad_alloc instead.
+	class no_default_resource {
+	public:
+		no_default_resource()
+		: previous_(std::pmr::set_default_resource(std::pmr::null_memory_resource())) {}
+		~no_default_resource() {
+			std::pmr::set_default_resource(previous_);
+		}
+		no_default_resource(no_default_resource const&) = delete;
+		auto operator=(no_default_resource const&) -> no_default_resource& = delete;
+
+	private:
+		std::pmr::memory_resource* previous_;
+	};
+} // namespace
+
+TEST_CASE("graph in a monotonic arena", "[gdwg.allocator]") {
+	auto buffer = std::array<std::byte, 1 << 16>{};
+	auto arena = std::pmr::monotonic_buffer_resource(buffer.data(),
+	                                                 buffer.size(),
+	                                                 std::pmr::null_memory_resource());
+	auto const guard = no_default_resource{};
+
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4}, &arena);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 1, 5);
+	g.insert_edge(4, 4, 6);
+	g.replace_node(4, 5);
+	g.merge_replace_node(1, 2);
+	g.erase_node(3);
+	CHECK(g.nodes() == std::vector<int>{2, 5});
+	CHECK(g.connections(2) == std::vector<int>{2});
+	CHECK(g.is_connected(5, 5));
+}
+
+TEST_CASE("get_allocator() and allocator-extended copy", "[gdwg.allocator]") {
+	auto first = counting_resource{};
+	auto second = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4}, &first);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 1, 5);
+	g.insert_edge(4, 4, 6);
+	CHECK(g.get_allocator().resource() == &first);
+	CHECK(first.live > 0);
+
+	auto const copy = gdwg::pmr::graph<int, int>(g, &second);
+	CHECK(copy == g);
+	CHECK(copy.get_allocator().resource() == &second);
+	CHECK(second.live > 0);
+}
+
+TEST_CASE("move construction keeps the allocator", "[gdwg.allocator]") {
+	auto resource = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4}, &resource);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 1, 5);
+	g.insert_edge(4, 4, 6);
+	auto const total = resource.total;
+
+	auto const moved = std::move(g);
+	CHECK(moved.get_allocator().resource() == &resource);
+	CHECK(resource.total == total);
+	CHECK(g.empty());
+}
+
+TEST_CASE("move assignment between memory resources", "[gdwg.allocator]") {
+	auto first = counting_resource{};
+	auto second = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4}, &first);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 1, 5);
+	g.insert_edge(4, 4, 6);
+	auto const expected = gdwg::pmr::graph<int, int>(g, std::pmr::new_delete_resource());
+
+	SECTION("same resource") {
+		auto target = gdwg::pmr::graph<int, int>(&first);
+		auto const total = first.total;
+		target = std::move(g);
+		CHECK(first.total == total);
+		CHECK(target == expected);
+	}
+
+	SECTION("different resource") {
+		auto target = gdwg::pmr::graph<int, int>(&second);
+		target = std::move(g);
+		CHECK(target.get_allocator().resource() == &second);
+		CHECK(target == expected);
+		CHECK(g.empty());
+		CHECK(g.get_allocator().resource() == &first);
+	}
+}
+
+TEST_CASE("copy assignment keeps the allocator of the target", "[gdwg.allocator]") {
+	auto first = counting_resource{};
+	auto second = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4}, &first);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 1, 5);
+	g.insert_edge(4, 4, 6);
+	auto target = gdwg::pmr::graph<int, int>({7}, &second);
+	auto const live = first.live;
+
+	target = g;
+	CHECK(target == g);
+	CHECK(target.get_allocator().resource() == &second);
+	CHECK(first.live == live);
+}
+
+TEST_CASE("allocations per edge", "[gdwg.allocator]") {
+	auto resource = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2}, &resource);
+
+	// One tree node in the edge set, and one in the incoming index of the destination.
+	auto const before = resource.live;
+	CHECK(g.insert_edge(1, 2, 3));
+	CHECK(resource.live == before + 2);
+	CHECK(g.erase_edge(1, 2, 3));
+	CHECK(resource.live == before);
+}
+
+TEST_CASE("merge_replace_node() allocates nothing", "[gdwg.allocator]") {
+	auto resource = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4, 5}, &resource);
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(1, 1, 2);
+	g.insert_edge(3, 1, 3);
+	g.insert_edge(1, 4, 4);
+	g.insert_edge(2, 4, 4);
+	g.insert_edge(2, 2, 5);
+	// Leaves room in the list of released ids, which is the only thing the merge may grow.
+	g.erase_node(5);
+	g.insert_node(5);
+
+	auto const total = resource.total;
+	g.merge_replace_node(1, 2);
+	CHECK(resource.total == total);
+	CHECK(g.connections(2) == std::vector<int>{2, 2, 2, 4});
+	CHECK(g.weights(2, 2) == std::vector<int>{1, 2, 5});
+	CHECK(g.predecessors(2) == std::vector<int>{2, 2, 2, 3});
+	CHECK(g.predecessors(4) == std::vector<int>{2});
+}
+
+TEST_CASE("rejected inserts allocate nothing", "[gdwg.allocator]") {
+	auto resource = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4}, &resource);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 1, 5);
+	g.insert_edge(4, 4, 6);
+
+	auto const total = resource.total;
+	CHECK_FALSE(g.insert_node(1));
+	CHECK_FALSE(g.emplace_node(2));
+	CHECK_FALSE(g.insert_edge(1, 2, 3));
+	CHECK_FALSE(g.emplace_edge(4, 4, 6));
+	CHECK(resource.total == total);
+}
+
+TEST_CASE("reserve() leaves only per-node allocations", "[gdwg.allocator]") {
+	auto resource = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>(&resource);
+	g.reserve(100, 0);
+
+	// The node with its control block, its tree node in the node set, and its hashed index entry.
+	auto const total = resource.total;
+	for (auto i = 0; i < 100; ++i) {
+		g.insert_node(i);
+	}
+	CHECK(resource.total == total + 3 * 100);
+}
+
+TEST_CASE("re-inserting erased edges reuses their tombstones", "[gdwg.allocator]") {
+	auto resource = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>({1, 2, 3, 4}, &resource);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 1, 5);
+	g.insert_edge(4, 4, 6);
+	g.max_dead_ratio(1);
+	g.erase_edge(1, 2, 3);
+	g.erase_edge(2, 3, 4);
+
+	auto const total = resource.total;
+	CHECK(g.insert_edge(1, 3, 7));
+	CHECK(g.insert_edge(1, 2, 3));
+	CHECK(resource.total == total);
+	CHECK(g.predecessors(3) == std::vector<int>{1});
+
+	auto const live = resource.live;
+	g.compact();
+	CHECK(g.insert_edge(2, 3, 4));
+	CHECK(resource.live == live + 2);
+}
@@ -0,0 +1,168 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.modifiers & gdwg.accessors to check that committing a
+              gdwg::graph::batch has the same result as making its calls one by one, and that a
+              batch which would fail changes nothing.
+ * @approach:
+    * 1. Test an empty batch.
+    * 2. Test nothing is applied before commit().
+    * 3. Test a batch of insertions matches inserting one by one.
+    * 4. Test a mixed batch matches making the same calls in order.
+    * 5. Test operations see the nodes added and removed earlier in the batch.
+    * 6. Test exception, and that a failing batch changes nothing.
+ */
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("empty batch", "[gdwg.batch]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("liao", "fan", 3);
+	g.insert_edge("fan", "wang", 4);
+	auto const original = g;
+	auto b = gdwg::graph<std::string, int>::batch(g);
+	CHECK(b.size() == 0);
+	b.commit();
+	CHECK(g == original);
+}
+
+TEST_CASE("nothing is applied before commit()", "[gdwg.batch]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("liao", "fan", 3);
+	g.insert_edge("fan", "wang", 4);
+	auto b = gdwg::graph<std::string, int>::batch(g);
+	b.insert_node("chen");
+	b.erase_edge("wang", "liao", 1);
+	CHECK(b.size() == 2);
+	CHECK_FALSE(g.is_node("chen"));
+	CHECK(g.is_connected("wang", "liao"));
+
+	b.commit();
+	CHECK(b.size() == 0);
+	CHECK(g.is_node("chen"));
+	CHECK_FALSE(g.is_connected("wang", "liao"));
+}
+
+TEST_CASE("batch of insertions", "[gdwg.batch]") {
+	auto g = gdwg::graph<std::string, int>{};
+	auto expected = gdwg::graph<std::string, int>{};
+	auto b = gdwg::graph<std::string, int>::batch(g);
+	for (auto i = 0; i < 200; ++i) {
+		auto const n = std::to_string((i * 37) % 100);
+		b.insert_node(n);
+		expected.insert_node(n);
+	}
+	for (auto i = 0; i < 500; ++i) {
+		auto const src = std::to_string((i * 13) % 100);
+		auto const dst = std::to_string((i * 7) % 100);
+		b.insert_edge(src, dst, i % 3);
+		expected.insert_edge(src, dst, i % 3);
+	}
+	b.commit();
+	CHECK(g == expected);
+	CHECK(g.predecessors("0") == expected.predecessors("0"));
+}
+
+TEST_CASE("mixed batch", "[gdwg.batch]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("liao", "fan", 3);
+	g.insert_edge("fan", "wang", 4);
+	auto expected = g;
+	auto b = gdwg::graph<std::string, int>::batch(g);
+
+	b.insert_node("chen");
+	b.insert_edge("chen", "wang", 5);
+	b.insert_edge("wang", "chen", 6);
+	b.erase_edge("wang", "shi", 2);
+	b.erase_edge("wang", "shi", 7);
+	b.replace_node("liao", "zhou");
+	b.insert_edge("zhou", "shi", 8);
+	b.erase_node("fan");
+	b.insert_node("fan");
+	b.insert_edge("fan", "fan", 9);
+	b.commit();
+
+	expected.insert_node("chen");
+	expected.insert_edge("chen", "wang", 5);
+	expected.insert_edge("wang", "chen", 6);
+	expected.erase_edge("wang", "shi", 2);
+	expected.erase_edge("wang", "shi", 7);
+	expected.replace_node("liao", "zhou");
+	expected.insert_edge("zhou", "shi", 8);
+	expected.erase_node("fan");
+	expected.insert_node("fan");
+	expected.insert_edge("fan", "fan", 9);
+
+	CHECK(g == expected);
+	CHECK(g.nodes() == std::vector<std::string>{"chen", "fan", "shi", "wang", "zhou"});
+	CHECK(g.connections("wang") == std::vector<std::string>{"chen", "zhou"});
+	CHECK(g.predecessors("wang") == std::vector<std::string>{"chen"});
+	CHECK(g.connections("fan") == std::vector<std::string>{"fan"});
+}
+
+TEST_CASE("operations see earlier operations of the batch", "[gdwg.batch]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("liao", "fan", 3);
+	g.insert_edge("fan", "wang", 4);
+	auto b = gdwg::graph<std::string, int>::batch(g);
+
+	SECTION("a node inserted earlier") {
+		b.insert_node("chen");
+		b.replace_node("chen", "zhou");
+		b.insert_edge("zhou", "zhou", 1);
+		b.commit();
+		CHECK_FALSE(g.is_node("chen"));
+		CHECK(g.is_connected("zhou", "zhou"));
+	}
+
+	SECTION("a node replaced by one that already exists") {
+		b.replace_node("wang", "liao");
+		b.insert_edge("wang", "fan", 1);
+		b.commit();
+		CHECK(g.connections("wang") == std::vector<std::string>{"fan", "liao", "shi"});
+	}
+}
+
+TEST_CASE("exception", "[gdwg.batch]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("liao", "fan", 3);
+	g.insert_edge("fan", "wang", 4);
+	auto const original = g;
+	auto b = gdwg::graph<std::string, int>::batch(g);
+	b.insert_node("chen");
+	b.insert_edge("chen", "wang", 1);
+	b.erase_node("wang");
+
+	SECTION("insert_edge() on a node erased earlier") {
+		b.insert_edge("shi", "wang", 2);
+		CHECK_THROWS_WITH(b.commit(),
+		                  "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst "
+		                  "node does not exist");
+		CHECK(b.size() == 4);
+	}
+
+	SECTION("erase_edge() on a node that was never there") {
+		b.erase_edge("shi", "zhou", 2);
+		CHECK_THROWS_AS(b.commit(), std::runtime_error);
+		CHECK(b.size() == 4);
+	}
+
+	SECTION("replace_node() on a node replaced earlier") {
+		b.replace_node("liao", "zhou");
+		b.replace_node("liao", "chen");
+		CHECK_THROWS_AS(b.commit(), std::runtime_error);
+		CHECK(b.size() == 5);
+	}
+
+	CHECK(g == original);
+}
@@ -9,6 +9,9 @@
     * 4. Test comparison operator != with empty graph.
     * 5. Test comparison operator != with nodes.
     * 6. Test comparison operator != with nodes and edges.
+    * 7. Test diff of equal graphs.
+    * 8. Test diff with added and removed nodes and edges.
+    * 9. Test diff against an empty graph.
  */
 
 #include "gdwg/graph.hpp"
@@ -67,4 +70,63 @@ TEST_CASE("comparison operator != with nodes and edges", "[gdwg.comparison]") {
 	g1.insert_edge("wang", "liao", 1);
 	g2.insert_edge("wang", "liao", 2);
 	CHECK(g1 != g2);
-}
\ No newline at end of file
+}
+
+TEST_CASE("diff of equal graphs", "[gdwg.comparison]") {
+	auto g1 = gdwg::graph<std::string, int>{"wang", "liao"};
+	g1.insert_edge("wang", "liao", 1);
+	auto g2 = gdwg::graph<std::string, int>{"liao", "wang"};
+	g2.insert_edge("wang", "liao", 1);
+	CHECK(diff(g1, g2).empty());
+	CHECK(diff(gdwg::graph<std::string, int>{}, gdwg::graph<std::string, int>{}).empty());
+}
+
+TEST_CASE("diff with added and removed nodes and edges", "[gdwg.comparison]") {
+	auto g1 = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	g1.insert_edge("wang", "liao", 1);
+	g1.insert_edge("wang", "liao", 2);
+	g1.insert_edge("shi", "wang", 3);
+	auto g2 = gdwg::graph<std::string, int>{"wang", "liao", "xu"};
+	g2.insert_edge("wang", "liao", 2);
+	g2.insert_edge("wang", "liao", 4);
+	g2.insert_edge("xu", "wang", 3);
+	g2.insert_edge("liao", "liao", 5);
+
+	using edge = gdwg::graph<std::string, int>::value_type;
+	auto const to_tuples = [](std::vector<edge> const& edges) {
+		auto tuples = std::vector<std::tuple<std::string, std::string, int>>{};
+		std::transform(edges.begin(), edges.end(), std::back_inserter(tuples), [](auto const& e) {
+			return std::make_tuple(e.from, e.to, e.weight);
+		});
+		return tuples;
+	};
+	auto const d = diff(g1, g2);
+	CHECK(d.added_nodes == std::vector<std::string>{"xu"});
+	CHECK(d.removed_nodes == std::vector<std::string>{"shi"});
+	CHECK(to_tuples(d.added_edges)
+	      == std::vector<std::tuple<std::string, std::string, int>>{{"liao", "liao", 5},
+	                                                                {"wang", "liao", 4},
+	                                                                {"xu", "wang", 3}});
+	CHECK(to_tuples(d.removed_edges)
+	      == std::vector<std::tuple<std::string, std::string, int>>{{"shi", "wang", 3},
+	                                                                {"wang", "liao", 1}});
+
+	auto const back = diff(g2, g1);
+	CHECK(back.added_nodes == d.removed_nodes);
+	CHECK(back.removed_nodes == d.added_nodes);
+	CHECK(to_tuples(back.added_edges) == to_tuples(d.removed_edges));
+	CHECK(to_tuples(back.removed_edges) == to_tuples(d.added_edges));
+}
+
+TEST_CASE("diff against an empty graph", "[gdwg.comparison]") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	g.insert_edge(2, 1, 7);
+	auto const d = diff(gdwg::graph<int, int>{}, g);
+	CHECK(d.added_nodes == std::vector<int>{1, 2});
+	CHECK(d.removed_nodes.empty());
+	REQUIRE(d.added_edges.size() == 1);
+	CHECK(d.added_edges.front().from == 2);
+	CHECK(d.added_edges.front().to == 1);
+	CHECK(d.added_edges.front().weight == 7);
+	CHECK(d.removed_edges.empty());
+}
@@ -6,10 +6,12 @@
     * 1. Test default constructor.
     * 2. Test initializer list constructor.
     * 3. Test iterator constructor.
-    * 4. Test copy constructor.
-    * 5. Test move constructor.
-    * 6. Test copy assignment operator.
-    * 7. Test move assignment operator.
+    * 4. Test edge iterator constructor.
+    * 5. Test copy constructor.
+    * 6. Test copy constructor with edges.
+    * 7. Test move constructor.
+    * 8. Test copy assignment operator.
+    * 9. Test move assignment operator.
  */
 
 #include "gdwg/graph.hpp"
@@ -85,6 +87,25 @@ TEST_CASE("iterator constructor", "[gdwg.constructors]") {
 	}
 }
 
+TEST_CASE("edge iterator constructor", "[gdwg.constructors]") {
+	auto const edges = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"wang", "liao", 2},
+	   {"shi", "wang", 1},
+	   {"wang", "liao", 2},
+	   {"fan", "fan", 3},
+	};
+	auto const g = gdwg::graph<std::string, int>(edges.begin(), edges.end());
+	CHECK(g.nodes() == std::vector<std::string>{"fan", "liao", "shi", "wang"});
+	CHECK(g.weights("wang", "liao") == std::vector<int>{2});
+	CHECK(g.is_connected("shi", "wang"));
+	CHECK(g.is_connected("fan", "fan"));
+
+	SECTION("from another graph") {
+		auto const copy = gdwg::graph<std::string, int>(g.begin(), g.end());
+		CHECK(copy == g);
+	}
+}
+
 TEST_CASE("copy constructor", "[gdwg.constructors]") {
 	auto const g1 = gdwg::graph<std::string, int>{"Wang", "Liao", "Shi", "Fan"};
 	auto copy_g1 = gdwg::graph(g1);
@@ -103,6 +124,33 @@ TEST_CASE("copy constructor", "[gdwg.constructors]") {
 	CHECK_FALSE(g1.is_connected("Wang", "Liao"));
 }
 
+TEST_CASE("copy constructor with edges", "[gdwg.constructors]") {
+	auto g1 = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+	g1.insert_edge(1, 2, 1);
+	g1.insert_edge(1, 2, 0);
+	g1.insert_edge(3, 1, 2);
+	g1.insert_edge(4, 1, 3);
+	g1.insert_edge(5, 5, 4);
+	g1.insert_edge(5, 1, 5);
+	// Leaves a gap in the ids of the nodes that are copied.
+	g1.erase_node(2);
+	g1.insert_node(6);
+	g1.insert_edge(6, 3, 6);
+
+	auto copy_g1 = gdwg::graph(g1);
+	CHECK(copy_g1 == g1);
+	CHECK(copy_g1.predecessors(1) == std::vector<int>{3, 4, 5});
+	CHECK(copy_g1.predecessors(3) == std::vector<int>{6});
+	CHECK(copy_g1.connections(5) == std::vector<int>{1, 5});
+
+	copy_g1.erase_node(1);
+	copy_g1.insert_edge(6, 5, 7);
+	CHECK(copy_g1.connections(6) == std::vector<int>{3, 5});
+	CHECK(copy_g1.predecessors(5) == std::vector<int>{5, 6});
+	CHECK(g1.connections(6) == std::vector<int>{3});
+	CHECK(g1.predecessors(1) == std::vector<int>{3, 4, 5});
+}
+
 TEST_CASE("move constructor", "[gdwg.constructors]") {
 	auto const g1 = gdwg::graph<std::string, int>{"Wang", "Liao", "Shi", "Fan"};
 	auto move_g1 = gdwg::graph(std::move(g1));
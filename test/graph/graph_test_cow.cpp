@@ -0,0 +1,144 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.constructors & gdwg.modifiers to check that copies of a
+              gdwg::cow_graph share their graph until one of them is modified, and that modifying
+              one copy never shows through in another.
+ * @approach:
+    * 1. Test constructors.
+    * 2. Test copies share their graph.
+    * 3. Test mutate() copies a shared graph once.
+    * 4. Test mutate() of a graph nobody else shares.
+    * 5. Test mutate() keeps the allocator.
+    * 6. Test comparison and extractor.
+    * 7. Test copies mutated and dropped on other threads.
+ */
+
+#include "gdwg/cow_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory_resource>
+#include <thread>
+
+TEST_CASE("cow_graph constructors", "[gdwg.cow]") {
+	auto const empty = gdwg::cow_graph<std::string, int>{};
+	CHECK(empty->empty());
+
+	auto g = gdwg::graph<std::string, int>{"wang"};
+	auto const from_graph = gdwg::cow_graph<std::string, int>(std::move(g));
+	CHECK(from_graph->nodes() == std::vector<std::string>{"wang"});
+	CHECK_FALSE(from_graph.is_shared());
+}
+
+TEST_CASE("cow_graph copies share their graph", "[gdwg.cow]") {
+	auto g = gdwg::cow_graph<std::string, int>{"wang", "liao", "shi"};
+	g.mutate().insert_edge("wang", "liao", 1);
+	g.mutate().insert_edge("liao", "shi", 2);
+	auto const copy = g;
+	CHECK(copy.shares_graph_with(g));
+	CHECK(g.is_shared());
+	CHECK(&copy.read() == &g.read());
+	CHECK(copy->connections("wang") == std::vector<std::string>{"liao"});
+}
+
+TEST_CASE("cow_graph mutate() of a shared graph", "[gdwg.cow]") {
+	auto g = gdwg::cow_graph<std::string, int>{"wang", "liao", "shi"};
+	g.mutate().insert_edge("wang", "liao", 1);
+	g.mutate().insert_edge("liao", "shi", 2);
+	auto copy = g;
+	auto& own = copy.mutate();
+	CHECK_FALSE(copy.shares_graph_with(g));
+	CHECK_FALSE(g.is_shared());
+	CHECK(&own == &copy.read());
+
+	own.insert_edge("shi", "wang", 3);
+	own.erase_node("liao");
+	CHECK(copy->nodes() == std::vector<std::string>{"shi", "wang"});
+	CHECK(g->nodes() == std::vector<std::string>{"liao", "shi", "wang"});
+	CHECK(g->is_connected("wang", "liao"));
+	CHECK_FALSE(g->is_connected("shi", "wang"));
+
+	// A second mutate() has nothing left to copy.
+	CHECK(&copy.mutate() == &own);
+}
+
+TEST_CASE("cow_graph mutate() of an unshared graph", "[gdwg.cow]") {
+	auto g = gdwg::cow_graph<std::string, int>{"wang", "liao", "shi"};
+	g.mutate().insert_edge("wang", "liao", 1);
+	g.mutate().insert_edge("liao", "shi", 2);
+	auto const* const before = &g.read();
+	g.mutate().insert_node("fan");
+	CHECK(&g.read() == before);
+	CHECK(g->is_node("fan"));
+}
+
+TEST_CASE("cow_graph mutate() keeps the allocator", "[gdwg.cow]") {
+	auto arena = std::pmr::monotonic_buffer_resource{};
+	auto const g = gdwg::cow_graph<int, int, std::pmr::polymorphic_allocator<std::byte>>(
+	   gdwg::pmr::graph<int, int>({1, 2, 3}, &arena));
+	CHECK(g.get_allocator().resource() == &arena);
+
+	auto copy = g;
+	copy.mutate().insert_edge(2, 3, 4);
+	CHECK(copy.get_allocator().resource() == &arena);
+	CHECK(copy->is_connected(2, 3));
+	CHECK_FALSE(g->is_connected(2, 3));
+}
+
+TEST_CASE("cow_graph comparison and extractor", "[gdwg.cow]") {
+	auto g = gdwg::cow_graph<std::string, int>{"wang", "liao", "shi"};
+	g.mutate().insert_edge("wang", "liao", 1);
+	g.mutate().insert_edge("liao", "shi", 2);
+	auto copy = g;
+	CHECK(copy == g);
+	copy.mutate();
+	CHECK(copy == g);
+	copy.mutate().insert_node("fan");
+	CHECK_FALSE(copy == g);
+
+	auto expected = std::ostringstream{};
+	expected << g.read();
+	auto out = std::ostringstream{};
+	out << g;
+	CHECK(out.str() == expected.str());
+}
+
+TEST_CASE("cow_graph copies on other threads", "[gdwg.cow]") {
+	auto g = gdwg::cow_graph<std::string, int>{"wang", "liao", "shi"};
+	g.mutate().insert_edge("wang", "liao", 1);
+
+	// Each thread mutates its own copy while the others still share the graph. Catch assertions
+	// aren't thread-safe, so the threads only record what they saw.
+	auto seen = std::vector<std::vector<int>>(4);
+	auto writers = std::vector<std::thread>{};
+	for (auto i = 0; i < 4; ++i) {
+		writers.emplace_back([copy = g, i, &seen]() mutable {
+			copy.mutate().insert_edge("liao", "shi", i);
+			seen[static_cast<std::size_t>(i)] = copy->weights("liao", "shi");
+		});
+	}
+	for (auto& writer : writers) {
+		writer.join();
+	}
+	CHECK(seen == std::vector<std::vector<int>>{{0}, {1}, {2}, {3}});
+	CHECK_FALSE(g.is_shared());
+	CHECK_FALSE(g->is_connected("liao", "shi"));
+
+	// A copy read and dropped on another thread leaves the graph to be modified in place.
+	auto const* const before = &g.read();
+	auto dropped = std::atomic<bool>{false};
+	auto connections = std::vector<std::string>{};
+	auto reader = std::thread([copy = g, &connections, &dropped]() mutable {
+		connections = copy->connections("wang");
+		copy = gdwg::cow_graph<std::string, int>{};
+		dropped.store(true, std::memory_order_relaxed);
+	});
+	while (not dropped.load(std::memory_order_relaxed)) {
+		std::this_thread::yield();
+	}
+	CHECK(&g.mutate() == before);
+	g.mutate().erase_node("wang");
+	reader.join();
+	CHECK(connections == std::vector<std::string>{"liao"});
+	CHECK(g->nodes() == std::vector<std::string>{"liao", "shi"});
+}
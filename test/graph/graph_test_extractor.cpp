@@ -6,6 +6,7 @@
     * 1. Test extractor with empty graph.
     * 2. Test extractor with simple graph.
     * 3. Test extractor with complex graph.
+    * 4. Test extractor with multiple edges between two nodes.
  */
 
 #include "gdwg/graph.hpp"
@@ -92,4 +93,20 @@ TEST_CASE("extractor with complex graph", "[gdwg.extractor]") {
 )
 )");
 	CHECK(out.str() == expected);
-}
\ No newline at end of file
+}
+
+TEST_CASE("extractor with multiple edges between two nodes", "[gdwg.extractor]") {
+	auto g = gdwg::graph<std::string, int>{"hello", "are"};
+	g.insert_edge("hello", "are", 8);
+	g.insert_edge("hello", "are", 2);
+	auto out = std::ostringstream{};
+	out << g;
+	auto const expected = std::string_view(R"(are (
+)
+hello (
+  are | 2
+  are | 8
+)
+)");
+	CHECK(out.str() == expected);
+}
@@ -0,0 +1,275 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.constructors & gdwg.modifiers & gdwg.accessors to check that
+              gdwg::flat_graph behaves exactly like gdwg::graph, both while insertions are still
+              buffered and after they have been merged.
+ * @approach:
+    * 1. Test insert_node() and insert_edge() before and after a merge.
+    * 2. Test that a large number of insertions matches gdwg::graph.
+    * 3. Test merge_replace_node() and replace_node().
+    * 4. Test erase_node() and erase_edge().
+    * 5. Test iterator traversal and find().
+    * 6. Test comparison and extractor.
+    * 7. Test insert_edges() of sorted edges.
+    * 8. Test reserve() and shrink_to_fit().
+    * 9. Test that reads see buffered insertions without merging them.
+    * 10. Test exception.
+ */
+
+#include "gdwg/flat_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("flat_graph insert_node() and insert_edge()", "[gdwg.flat]") {
+	auto g = gdwg::flat_graph<std::string, int>{"wang", "liao", "shi"};
+	CHECK_FALSE(g.insert_node("wang"));
+	CHECK(g.insert_node("fan"));
+	CHECK(g.insert_edge("wang", "fan", 1));
+	CHECK_FALSE(g.insert_edge("wang", "fan", 1));
+	CHECK(g.insert_edge("wang", "liao", 2));
+
+	SECTION("while buffered") {
+		CHECK(g.is_connected("wang", "fan"));
+		CHECK(g.connections("wang") == std::vector<std::string>{"fan", "liao"});
+	}
+
+	SECTION("after flush()") {
+		g.flush();
+		CHECK_FALSE(g.insert_edge("wang", "fan", 1));
+		CHECK(g.insert_edge("wang", "fan", 0));
+		CHECK(g.weights("wang", "fan") == std::vector<int>{0, 1});
+		CHECK(g.nodes() == std::vector<std::string>{"fan", "liao", "shi", "wang"});
+	}
+}
+
+TEST_CASE("flat_graph matches graph after many insertions", "[gdwg.flat]") {
+	auto flat = gdwg::flat_graph<int, int>{};
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < 500; ++i) {
+		auto const n = (i * 37) % 500;
+		CHECK(flat.insert_node(n) == g.insert_node(n));
+	}
+	for (auto i = 0; i < 2000; ++i) {
+		auto const src = (i * 13) % 500;
+		auto const dst = (i * 7) % 500;
+		auto const weight = i % 3;
+		CHECK(flat.insert_edge(src, dst, weight) == g.insert_edge(src, dst, weight));
+	}
+
+	CHECK(flat.nodes() == g.nodes());
+	auto expected = std::ostringstream{};
+	expected << g;
+	auto out = std::ostringstream{};
+	out << flat;
+	CHECK(out.str() == expected.str());
+}
+
+TEST_CASE("flat_graph merge_replace_node() and replace_node()", "[gdwg.flat]") {
+	auto g = gdwg::flat_graph<std::string, int>{"A", "B", "C", "D"};
+	g.insert_edge("A", "B", 1);
+	g.insert_edge("A", "C", 2);
+	g.insert_edge("A", "D", 3);
+	g.insert_edge("B", "B", 1);
+
+	SECTION("merge_replace_node()") {
+		g.merge_replace_node("A", "B");
+		CHECK_FALSE(g.is_node("A"));
+		CHECK(g.connections("B") == std::vector<std::string>{"B", "C", "D"});
+	}
+
+	SECTION("replace_node()") {
+		CHECK_FALSE(g.replace_node("A", "B"));
+		CHECK(g.replace_node("A", "E"));
+		CHECK(g.nodes() == std::vector<std::string>{"B", "C", "D", "E"});
+		CHECK(g.connections("E") == std::vector<std::string>{"B", "C", "D"});
+		CHECK(g.connections("B") == std::vector<std::string>{"B"});
+	}
+}
+
+TEST_CASE("flat_graph erase_node() and erase_edge()", "[gdwg.flat]") {
+	auto g = gdwg::flat_graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("liao", "wang", 2);
+	g.insert_edge("shi", "fan", 3);
+
+	SECTION("erase_node()") {
+		CHECK(g.erase_node("liao"));
+		CHECK_FALSE(g.erase_node("liao"));
+		CHECK(g.connections("wang").empty());
+		CHECK(g.connections("shi") == std::vector<std::string>{"fan"});
+	}
+
+	SECTION("erase_edge()") {
+		CHECK(g.erase_edge("wang", "liao", 1));
+		CHECK_FALSE(g.erase_edge("wang", "liao", 1));
+		CHECK_FALSE(g.is_connected("wang", "liao"));
+	}
+
+	SECTION("erase_edge() through iterators") {
+		auto const next = g.erase_edge(g.find("liao", "wang", 2));
+		CHECK((*next).from == "shi");
+		auto const last = g.erase_edge(g.begin(), g.end());
+		CHECK(last == g.end());
+		CHECK(g.begin() == g.end());
+	}
+}
+
+TEST_CASE("flat_graph iterator", "[gdwg.flat]") {
+	auto g = gdwg::flat_graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("wang", "fan", 3);
+	g.insert_edge("wang", "chen", 4);
+
+	auto it = g.begin();
+	CHECK((*it).to == "chen");
+	++it;
+	CHECK((*it).to == "fan");
+	it = g.end();
+	--it;
+	CHECK((*it).to == "shi");
+	CHECK(g.find("wang", "liao", 1) == std::next(g.begin(), 2));
+	CHECK(g.find("wang", "liao", 2) == g.end());
+}
+
+TEST_CASE("flat_graph comparison and extractor", "[gdwg.flat]") {
+	auto g1 = gdwg::flat_graph<int, int>{1, 2};
+	auto g2 = gdwg::flat_graph<int, int>{2, 1};
+	g1.insert_edge(1, 2, 3);
+	CHECK(g1 != g2);
+	g2.insert_edge(1, 2, 3);
+	CHECK(g1 == g2);
+
+	auto out = std::ostringstream{};
+	out << g1;
+	CHECK(out.str() == "1 (\n  2 | 3\n)\n2 (\n)\n");
+}
+
+TEST_CASE("flat_graph insert_edges() of sorted edges", "[gdwg.flat]") {
+	using edge = gdwg::flat_graph<int, int>::value_type;
+	auto g = gdwg::flat_graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 1);
+
+	SECTION("appended after every edge") {
+		auto const edges = std::vector<edge>{{1, 2, 2}, {1, 3, 1}, {2, 1, 0}, {3, 3, 3}};
+		CHECK(g.insert_edges(gdwg::sorted_unique, edges.begin(), edges.end()) == 4);
+		CHECK(g.weights(1, 2) == std::vector<int>{1, 2});
+		CHECK(g.connections(2) == std::vector<int>{1});
+		CHECK(g.connections(3) == std::vector<int>{3});
+	}
+
+	SECTION("the edges of a graph") {
+		auto source = gdwg::graph<int, int>{1, 2, 3};
+		source.insert_edge(1, 3, 1);
+		source.insert_edge(2, 2, 0);
+		CHECK(g.insert_edges(gdwg::sorted_unique, source.begin(), source.end()) == 2);
+		CHECK(g.connections(1) == std::vector<int>{2, 3});
+		CHECK(g.connections(2) == std::vector<int>{2});
+	}
+
+	SECTION("not sorted after all") {
+		auto const edges = std::vector<edge>{{3, 1, 0}, {1, 2, 1}, {1, 1, 5}, {3, 1, 0}};
+		CHECK(g.insert_edges(gdwg::sorted_unique, edges.begin(), edges.end()) == 2);
+		auto expected = gdwg::flat_graph<int, int>{1, 2, 3};
+		expected.insert_edge(1, 2, 1);
+		expected.insert_edge(3, 1, 0);
+		expected.insert_edge(1, 1, 5);
+		CHECK(g == expected);
+	}
+
+	SECTION("a missing endpoint") {
+		auto const edges = std::vector<edge>{{1, 3, 0}, {1, 4, 0}};
+		CHECK_THROWS_AS(g.insert_edges(gdwg::sorted_unique, edges.begin(), edges.end()),
+		                std::runtime_error);
+		CHECK(g.connections(1) == std::vector<int>{2});
+	}
+}
+
+TEST_CASE("flat_graph reserve() and shrink_to_fit()", "[gdwg.flat]") {
+	auto g = gdwg::flat_graph<int, int>{};
+	g.reserve(200, 400);
+	CHECK(g.node_capacity() >= 200);
+	CHECK(g.edge_capacity() >= 400);
+	auto const node_capacity = g.node_capacity();
+	auto const edge_capacity = g.edge_capacity();
+	for (auto i = 0; i < 200; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < 400; ++i) {
+		g.insert_edge(i % 200, (i * 7) % 200, i);
+	}
+	g.flush();
+	CHECK(g.node_capacity() == node_capacity);
+	CHECK(g.edge_capacity() == edge_capacity);
+
+	g.erase_node(0);
+	g.shrink_to_fit();
+	CHECK(g.node_capacity() == 199);
+	CHECK(g.edge_capacity() < edge_capacity);
+	CHECK(g.connections(1) == std::vector<int>{7, 7});
+}
+
+TEST_CASE("flat_graph reads leave buffered insertions in place", "[gdwg.flat]") {
+	auto g = gdwg::flat_graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(3, 1, 0);
+	g.flush();
+	auto const capacity = g.edge_capacity();
+	g.insert_node(0);
+	g.insert_edge(1, 2, 0);
+	g.insert_edge(0, 3, 2);
+
+	auto const& view = g;
+	CHECK(view.is_node(0));
+	CHECK(view.is_connected(0, 3));
+	CHECK(view.nodes() == std::vector<int>{0, 1, 2, 3});
+	CHECK(view.weights(1, 2) == std::vector<int>{0, 1});
+	CHECK(view.connections(1) == std::vector<int>{2, 2});
+	CHECK(view.find(1, 2, 0) == std::next(view.begin(), 1));
+	CHECK(view.find(1, 2, 1) == std::next(view.begin(), 2));
+	CHECK(view.find(3, 1, 0) == std::prev(view.end()));
+	CHECK(view.find(0, 3, 0) == view.end());
+
+	auto it = view.end();
+	--it;
+	CHECK((*it).from == 3);
+	--it;
+	CHECK((*it).weight == 1);
+	--it;
+	CHECK((*it).weight == 0);
+	--it;
+	CHECK((*it).from == 0);
+	CHECK(it == view.begin());
+
+	auto out = std::ostringstream{};
+	out << view;
+	CHECK(out.str() == "0 (\n  3 | 2\n)\n1 (\n  2 | 0\n  2 | 1\n)\n2 (\n)\n3 (\n  1 | 0\n)\n");
+	CHECK(view.edge_capacity() == capacity);
+
+	SECTION("erase_edge() of a buffered edge") {
+		auto const next = g.erase_edge(g.find(1, 2, 0));
+		CHECK((*next).weight == 1);
+		CHECK(g.weights(1, 2) == std::vector<int>{1});
+	}
+
+	SECTION("compared with a merged graph") {
+		auto merged = g;
+		merged.flush();
+		CHECK(merged.edge_capacity() > capacity);
+		CHECK(merged == g);
+		CHECK(std::equal(merged.begin(), merged.end(), g.begin(), g.end(), [](auto a, auto b) {
+			return std::tie(a.from, a.to, a.weight) == std::tie(b.from, b.to, b.weight);
+		}));
+	}
+}
+
+TEST_CASE("exception", "[gdwg.flat]") {
+	auto g = gdwg::flat_graph<std::string, int>{"wang", "liao"};
+	CHECK_THROWS_AS(g.insert_edge("wang", "", 1), std::runtime_error);
+	CHECK_THROWS_AS(g.replace_node("", "liao"), std::runtime_error);
+	CHECK_THROWS_AS(g.merge_replace_node("wang", ""), std::runtime_error);
+	CHECK_THROWS_AS(g.erase_edge("", "liao", 1), std::runtime_error);
+	CHECK_THROWS_AS(g.is_connected("wang", ""), std::runtime_error);
+	CHECK_THROWS_AS(g.weights("", "liao"), std::runtime_error);
+	CHECK_THROWS_AS(g.connections(""), std::runtime_error);
+}
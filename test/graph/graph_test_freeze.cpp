@@ -0,0 +1,138 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.constructors & gdwg.modifiers to build a graph, then freeze it and
+              check that the snapshot answers reads exactly like the graph it came from.
+ * @approach:
+    * 1. Test freeze() of an empty graph.
+    * 2. Test accessors of a frozen graph.
+    * 3. Test find() of a frozen graph.
+    * 4. Test iterating a frozen graph, forwards and backwards.
+    * 5. Test the extractor of a frozen graph.
+    * 6. Test the snapshot doesn't change when the graph does.
+    * 7. Test exception.
+ */
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("freeze() of an empty graph", "[gdwg.freeze]") {
+	auto const frozen = gdwg::graph<std::string, int>{}.freeze();
+	CHECK(frozen.empty());
+	CHECK(frozen.begin() == frozen.end());
+	CHECK_FALSE(frozen.is_node("wang"));
+}
+
+TEST_CASE("frozen graph accessors", "[gdwg.freeze]") {
+	auto g = gdwg::graph<int, int>{1, 7, 12, 14, 19, 21, 31};
+	g.insert_edge(1, 7, 4);
+	g.insert_edge(1, 12, 3);
+	g.insert_edge(1, 21, 12);
+	g.insert_edge(7, 21, 13);
+	g.insert_edge(12, 19, 16);
+	g.insert_edge(14, 14, 0);
+	g.insert_edge(19, 1, 3);
+	g.insert_edge(19, 21, 2);
+	g.insert_edge(21, 14, 23);
+	g.insert_edge(21, 31, 14);
+	g.insert_edge(21, 31, 9);
+	auto const frozen = g.freeze();
+
+	CHECK(frozen.nodes() == g.nodes());
+	CHECK(frozen.is_node(14));
+	CHECK_FALSE(frozen.is_node(2));
+	CHECK(frozen.is_connected(19, 21));
+	CHECK_FALSE(frozen.is_connected(21, 19));
+	CHECK(frozen.weights(21, 31) == std::vector<int>{9, 14});
+	CHECK(frozen.weights(31, 21).empty());
+	for (auto const n : g.nodes()) {
+		CHECK(frozen.connections(n) == g.connections(n));
+	}
+}
+
+TEST_CASE("frozen graph find()", "[gdwg.freeze]") {
+	auto g = gdwg::graph<int, int>{1, 19, 21};
+	g.insert_edge(19, 1, 3);
+	g.insert_edge(19, 21, 2);
+	auto const frozen = g.freeze();
+	auto const it = frozen.find(19, 1, 3);
+	REQUIRE_FALSE(it == frozen.end());
+	CHECK((*it).from == 19);
+	CHECK((*it).to == 1);
+	CHECK((*it).weight == 3);
+	CHECK(frozen.find(19, 1, 4) == frozen.end());
+	CHECK(frozen.find(19, 2, 3) == frozen.end());
+}
+
+TEST_CASE("frozen graph iterator", "[gdwg.freeze]") {
+	auto g = gdwg::graph<int, int>{1, 7, 12, 14, 19, 21, 31};
+	g.insert_edge(1, 7, 4);
+	g.insert_edge(1, 12, 3);
+	g.insert_edge(1, 21, 12);
+	g.insert_edge(7, 21, 13);
+	g.insert_edge(12, 19, 16);
+	g.insert_edge(14, 14, 0);
+	g.insert_edge(19, 1, 3);
+	g.insert_edge(19, 21, 2);
+	g.insert_edge(21, 14, 23);
+	g.insert_edge(21, 31, 14);
+	g.insert_edge(21, 31, 9);
+	auto const frozen = g.freeze();
+
+	SECTION("forwards") {
+		auto it = g.begin();
+		for (auto const& [from, to, weight] : frozen) {
+			REQUIRE_FALSE(it == g.end());
+			CHECK(from == (*it).from);
+			CHECK(to == (*it).to);
+			CHECK(weight == (*it).weight);
+			++it;
+		}
+		CHECK(it == g.end());
+	}
+
+	SECTION("backwards") {
+		auto it = frozen.end();
+		--it;
+		CHECK((*it).from == 21);
+		CHECK((*it).to == 31);
+		CHECK((*it).weight == 14);
+		--it;
+		--it;
+		--it;
+		CHECK((*it).from == 19);
+		CHECK((*it).to == 21);
+	}
+}
+
+TEST_CASE("frozen graph extractor", "[gdwg.freeze]") {
+	auto g = gdwg::graph<int, int>{1, 14, 21, 31};
+	g.insert_edge(1, 21, 12);
+	g.insert_edge(14, 14, 0);
+	g.insert_edge(21, 31, 14);
+	g.insert_edge(21, 31, 9);
+	auto expected = std::ostringstream{};
+	expected << g;
+	auto out = std::ostringstream{};
+	out << g.freeze();
+	CHECK(out.str() == expected.str());
+}
+
+TEST_CASE("frozen graph is a snapshot", "[gdwg.freeze]") {
+	auto g = gdwg::graph<int, int>{1, 21, 31};
+	g.insert_edge(1, 21, 12);
+	g.insert_edge(21, 31, 14);
+	auto const original = g;
+	auto const frozen = g.freeze();
+	g.erase_node(21);
+	g.insert_edge(31, 1, 0);
+	CHECK(frozen.is_node(21));
+	CHECK(frozen.connections(31).empty());
+	CHECK(frozen == original.freeze());
+}
+
+TEST_CASE("exception", "[gdwg.freeze]") {
+	auto const frozen = gdwg::graph<int, int>{1, 7}.freeze();
+	CHECK_THROWS_AS(frozen.is_connected(2, 1), std::runtime_error);
+	CHECK_THROWS_AS(frozen.weights(1, 2), std::runtime_error);
+	CHECK_THROWS_AS(frozen.connections(2), std::runtime_error);
+}
@@ -7,6 +7,7 @@
     * 2. Test iterator traversal ++
     * 3. Test iterator traversal --
     * 4. Test iterator comparison
+    * 5. Test iterator order follows node values after ids are reused
  */
 
 #include "gdwg/graph.hpp"
@@ -94,4 +95,23 @@ TEST_CASE("iterator comparison", "[gdwg.iterator]") {
 	++it;
 	++it2;
 	CHECK(it == it2);
-}
\ No newline at end of file
+}
+
+TEST_CASE("iterator order follows node values after ids are reused", "[gdwg.iterator]") {
+	auto g = gdwg::graph<std::string, int>{"zeta", "alpha", "mid"};
+	g.insert_edge("zeta", "alpha", 1);
+	g.insert_edge("alpha", "zeta", 2);
+	g.erase_node("mid");
+	g.insert_node("beta");
+	g.insert_edge("beta", "alpha", 3);
+	g.insert_edge("alpha", "beta", 4);
+
+	auto froms = std::vector<std::string>{};
+	auto tos = std::vector<std::string>{};
+	for (auto const& [from, to, weight] : g) {
+		froms.push_back(from);
+		tos.push_back(to);
+	}
+	CHECK(froms == std::vector<std::string>{"alpha", "alpha", "beta", "zeta"});
+	CHECK(tos == std::vector<std::string>{"beta", "zeta", "alpha", "alpha"});
+}
@@ -0,0 +1,164 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.modifiers & gdwg.comparisons to check that every modification of a
+              gdwg::journaled_graph can be undone back to the graph it started from, redone, and
+              replayed onto another graph.
+ * @approach:
+    * 1. Test only modifications that change the graph are recorded.
+    * 2. Test undo() and redo() of each modifier.
+    * 3. Test a new modification drops the undone deltas.
+    * 4. Test replay() onto another graph.
+    * 5. Test exception.
+ */
+
+#include "gdwg/journaled_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("journaled_graph records only changes", "[gdwg.journal]") {
+	auto base = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	base.insert_edge("wang", "liao", 1);
+	auto g = gdwg::journaled_graph<std::string, int>(base);
+	CHECK(g.history().empty());
+	CHECK_FALSE(g.insert_node("wang"));
+	CHECK_FALSE(g.insert_edge("wang", "liao", 1));
+	CHECK_FALSE(g.replace_node("wang", "liao"));
+	g.merge_replace_node("wang", "wang");
+	CHECK_FALSE(g.erase_node("xu"));
+	CHECK_FALSE(g.erase_edge("wang", "liao", 5));
+	CHECK(*g == base);
+	CHECK(g.history().empty());
+	CHECK_FALSE(g.can_undo());
+
+	CHECK(g.insert_node("xu"));
+	CHECK(g.insert_edge("xu", "wang", 5));
+	CHECK(g.history().size() == 2);
+	CHECK(g.can_undo());
+	CHECK_FALSE(g.can_redo());
+}
+
+TEST_CASE("journaled_graph undo() and redo()", "[gdwg.journal]") {
+	auto base = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	base.insert_edge("wang", "liao", 1);
+	base.insert_edge("wang", "wang", 2);
+	base.insert_edge("liao", "wang", 3);
+	base.insert_edge("shi", "liao", 1);
+	base.insert_edge("shi", "wang", 4);
+	auto g = gdwg::journaled_graph<std::string, int>(base);
+	auto states = std::vector<gdwg::graph<std::string, int>>{};
+	auto const step = [&](auto modify) {
+		states.push_back(*g);
+		modify();
+	};
+	step([&] { g.insert_node("xu"); });
+	step([&] { g.insert_edge("xu", "shi", 6); });
+	step([&] { g.replace_node("xu", "ye"); });
+	step([&] { g.merge_replace_node("shi", "wang"); });
+	step([&] { g.erase_edge("wang", "wang", 2); });
+	step([&] { g.erase_node("wang"); });
+	step([&] { g.clear(); });
+	states.push_back(*g);
+	CHECK(g.history().size() == 7);
+
+	// Undoing steps back through every state the graph went through.
+	for (auto state = states.rbegin(); state not_eq std::prev(states.rend()); ++state) {
+		CHECK(*g == *state);
+		CHECK(g.undo());
+	}
+	CHECK_FALSE(g.undo());
+	CHECK(*g == states.front());
+	CHECK(g.history().empty());
+
+	while (g.redo()) {
+	}
+	CHECK(*g == states.back());
+	CHECK(g.history().size() == 7);
+}
+
+TEST_CASE("journaled_graph merge_replace_node() undo keeps merged edges", "[gdwg.journal]") {
+	auto base = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	base.insert_edge("wang", "liao", 1);
+	base.insert_edge("wang", "wang", 2);
+	base.insert_edge("liao", "wang", 3);
+	base.insert_edge("shi", "liao", 1);
+	base.insert_edge("shi", "wang", 4);
+	auto g = gdwg::journaled_graph<std::string, int>(base);
+	// The first merge makes wang -> wang 1 out of wang -> liao 1. The second merges shi -> wang 1
+	// into it, so undoing the second has to leave it where it is.
+	g.merge_replace_node("liao", "wang");
+	g.insert_edge("shi", "wang", 7);
+	g.merge_replace_node("shi", "wang");
+	CHECK(g->nodes() == std::vector<std::string>{"wang"});
+	CHECK(g->weights("wang", "wang") == std::vector<int>{1, 2, 3, 4, 7});
+
+	CHECK(g.undo());
+	CHECK(g->weights("shi", "wang") == std::vector<int>{1, 4, 7});
+	CHECK(g->weights("wang", "wang") == std::vector<int>{1, 2, 3});
+	CHECK(g.undo());
+	CHECK(g.undo());
+	CHECK(*g == base);
+}
+
+TEST_CASE("journaled_graph modification drops undone deltas", "[gdwg.journal]") {
+	auto const base = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	auto g = gdwg::journaled_graph<std::string, int>(base);
+	g.insert_node("xu");
+	g.insert_node("ye");
+	CHECK(g.undo());
+	CHECK(g.can_redo());
+	g.insert_node("zhao");
+	CHECK_FALSE(g.can_redo());
+	CHECK(g.history().size() == 2);
+	CHECK(g.undo());
+	CHECK(g.undo());
+	CHECK(*g == base);
+
+	g.insert_node("xu");
+	g.clear_history();
+	CHECK_FALSE(g.can_undo());
+	CHECK(g->is_node("xu"));
+}
+
+TEST_CASE("journaled_graph replay()", "[gdwg.journal]") {
+	auto base = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	base.insert_edge("wang", "liao", 1);
+	base.insert_edge("wang", "wang", 2);
+	base.insert_edge("liao", "wang", 3);
+	base.insert_edge("shi", "liao", 1);
+	base.insert_edge("shi", "wang", 4);
+	auto source = gdwg::journaled_graph<std::string, int>(base);
+	source.insert_node("xu");
+	source.insert_edge("xu", "liao", 8);
+	source.erase_node("shi");
+	source.insert_node("ye");
+	CHECK(source.undo());
+
+	auto replica = gdwg::journaled_graph<std::string, int>(base);
+	replica.replay(source.history());
+	CHECK(*replica == *source);
+	CHECK(replica.history().size() == 3);
+
+	// Replaying a journal onto its own graph makes each modification again.
+	auto g = gdwg::journaled_graph<std::string, int>{"wang"};
+	g.insert_edge("wang", "wang", 1);
+	g.erase_edge("wang", "wang", 1);
+	g.replay(g.history());
+	CHECK(g->weights("wang", "wang").empty());
+	CHECK(g.history().size() == 4);
+}
+
+TEST_CASE("exception", "[gdwg.journal]") {
+	auto g = gdwg::journaled_graph<std::string, int>{"wang", "liao", "shi"};
+	CHECK_THROWS_AS(g.insert_edge("wang", "xu", 1), std::runtime_error);
+	CHECK_THROWS_AS(g.replace_node("xu", "ye"), std::runtime_error);
+	CHECK_THROWS_AS(g.merge_replace_node("xu", "wang"), std::runtime_error);
+	CHECK_THROWS_AS(g.merge_replace_node("xu", "xu"), std::runtime_error);
+	CHECK_THROWS_AS(g.erase_edge("xu", "wang", 1), std::runtime_error);
+	CHECK(g.history().empty());
+
+	auto source = gdwg::journaled_graph<std::string, int>{"ye"};
+	source.insert_node("xu");
+	source.insert_edge("xu", "ye", 1);
+	CHECK_THROWS_AS(g.replay(source.history()), std::runtime_error);
+	CHECK(g->is_node("xu"));
+	CHECK(g.history().size() == 1);
+}
@@ -5,19 +5,51 @@
  * @approach:
     * 1. Test insert_node() that add a node.
     * 2. Test insert_edge() that add an edge.
-    * 3. Test replace_node()that replace the old data
-    * 4. Test merge_replace_node() that replace the old data with new data
+    * 3. Test insert_node() and insert_edge() move from rvalues.
+    * 4. Test emplace_node() and emplace_edge() that construct in place.
+    * 5. Test insert_nodes() and insert_edges() that add many at once.
+    * 6. Test insert_edge() with a hint and insert_edges() of sorted edges.
+    * 7. Test replace_node()that replace the old data
+    * 8. Test merge_replace_node() that replace the old data with new data
          and change the associated edges.
-    * 5. Test erase_node() that erase a node.
-    * 6. Test erase_edge() that erase an edge.
-    * 7. Test clear that erase all nodes from the graph.
-    * 8. Test exception.
+    * 9. Test erase_node() that erase a node.
+    * 10. Test erase_edge() that erase an edge.
+    * 11. Test erase_nodes() and erase_edges() that erase many at once.
+    * 12. Test clear that erase all nodes from the graph.
+    * 13. Test reserve() and shrink_to_fit().
+    * 14. Test erase_edge() keeping tombstones, and compact().
+    * 15. Test try_ modifiers that don't throw.
+    * 16. Test exception.
  */
 
 #include "gdwg/graph.hpp"
 
 #include <catch2/catch.hpp>
 
+namespace {
+	// Counts how many times any value of this type has been copied.
+	struct counted {
+		static inline int copies = 0;
+
+		explicit counted(int v)
+		: value(v) {}
+		counted(int first, int second)
+		: value(first * 10 + second) {}
+		counted(counted const& other)
+		: value(other.value) {
+			++copies;
+		}
+		counted(counted&&) noexcept = default;
+		auto operator=(counted const&) -> counted& = default;
+		auto operator=(counted&&) noexcept -> counted& = default;
+		~counted() = default;
+
+		auto operator<=>(counted const&) const = default;
+
+		int value;
+	};
+} // namespace
+
 TEST_CASE("insert_node()", "[gdwg.modifiers]") {
 	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
 	g.insert_node("wangliao");
@@ -37,6 +69,166 @@ TEST_CASE("insert_edge()", "[gdwg.modifiers]") {
 	CHECK(edges == expected_edges);
 }
 
+TEST_CASE("insert_node() and insert_edge() with rvalues", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<counted, counted>{};
+	counted::copies = 0;
+	CHECK(g.insert_node(counted(1)));
+	CHECK(g.insert_node(counted(2)));
+	CHECK_FALSE(g.insert_node(counted(2)));
+	CHECK(g.insert_edge(counted(1), counted(2), counted(3)));
+	CHECK_FALSE(g.insert_edge(counted(1), counted(2), counted(3)));
+	CHECK(counted::copies == 0);
+
+	auto const weight = counted(4);
+	CHECK(g.insert_edge(counted(2), counted(1), weight));
+	CHECK(counted::copies == 1);
+	CHECK(g.is_connected(counted(2), counted(1)));
+}
+
+TEST_CASE("emplace_node() and emplace_edge()", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<counted, counted>{};
+	counted::copies = 0;
+	CHECK(g.emplace_node(1));
+	CHECK(g.emplace_node(1, 2));
+	CHECK_FALSE(g.emplace_node(12));
+	CHECK(g.emplace_edge(counted(1), counted(12), 3, 4));
+	CHECK_FALSE(g.emplace_edge(counted(1), counted(12), 34));
+	CHECK(g.emplace_edge(counted(12), counted(12), 5));
+	CHECK(counted::copies == 0);
+
+	CHECK(g.is_node(counted(12)));
+	CHECK(g.find(counted(1), counted(12), counted(34)) == g.begin());
+	CHECK(g.is_connected(counted(12), counted(12)));
+}
+
+TEST_CASE("insert_nodes()", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<std::string, int>{"liao", "wang"};
+	auto const values = std::vector<std::string>{"shi", "wang", "chen", "shi", "zhou", "fan"};
+	CHECK(g.insert_nodes(values.begin(), values.end()) == 4);
+	CHECK(g.nodes() == std::vector<std::string>{"chen", "fan", "liao", "shi", "wang", "zhou"});
+	CHECK(g.insert_nodes(values.begin(), values.end()) == 0);
+
+	g.insert_edge("zhou", "chen", 1);
+	CHECK(g.connections("zhou") == std::vector<std::string>{"chen"});
+}
+
+TEST_CASE("insert_edges()", "[gdwg.modifiers]") {
+	using edge = gdwg::graph<int, int>::value_type;
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(2, 3, 5);
+	auto const edges =
+	   std::vector<edge>{{3, 1, 2}, {1, 2, 7}, {2, 3, 5}, {1, 2, 7}, {1, 2, 6}, {4, 4, 0}};
+	CHECK(g.insert_edges(edges.begin(), edges.end()) == 4);
+	CHECK(g.insert_edges(edges.begin(), edges.end()) == 0);
+
+	auto expected = gdwg::graph<int, int>{1, 2, 3, 4};
+	for (auto const& [from, to, weight] : edges) {
+		expected.insert_edge(from, to, weight);
+	}
+	CHECK(g == expected);
+	CHECK(g.weights(1, 2) == std::vector<int>{6, 7});
+	CHECK(g.connections(1) == std::vector<int>{2, 2});
+	CHECK(g.predecessors(2) == std::vector<int>{1, 1});
+	CHECK(g.is_connected(4, 4));
+}
+
+TEST_CASE("insert_edge() with a hint", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	auto it = g.insert_edge(g.end(), 1, 2, 1);
+	CHECK(it == g.find(1, 2, 1));
+	it = g.insert_edge(std::next(it), 1, 3, 2);
+	it = g.insert_edge(std::next(it), 3, 1, 3);
+	CHECK(std::next(it) == g.end());
+
+	SECTION("an edge that is already there") {
+		auto const existing = g.find(1, 3, 2);
+		CHECK(g.insert_edge(g.end(), 1, 3, 2) == existing);
+		CHECK(g.weights(1, 3) == std::vector<int>{2});
+	}
+
+	SECTION("a hint in the wrong place") {
+		it = g.insert_edge(g.end(), 2, 2, 4);
+		CHECK(it == g.find(2, 2, 4));
+		it = g.insert_edge(g.begin(), 3, 3, 5);
+		CHECK(it == g.find(3, 3, 5));
+		CHECK(g.predecessors(3) == std::vector<int>{1, 3});
+		CHECK(g.connections(2) == std::vector<int>{2});
+	}
+}
+
+TEST_CASE("insert_edges() of sorted edges", "[gdwg.modifiers]") {
+	using edge = gdwg::graph<int, int>::value_type;
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 1);
+
+	SECTION("appended after every edge") {
+		auto const edges = std::vector<edge>{{1, 2, 2}, {1, 3, 1}, {2, 1, 0}, {3, 3, 3}};
+		CHECK(g.insert_edges(gdwg::sorted_unique, edges.begin(), edges.end()) == 4);
+		CHECK(g.weights(1, 2) == std::vector<int>{1, 2});
+		CHECK(g.predecessors(1) == std::vector<int>{2});
+		CHECK(g.connections(3) == std::vector<int>{3});
+	}
+
+	SECTION("not sorted after all") {
+		auto const edges = std::vector<edge>{{3, 1, 0}, {1, 2, 1}, {1, 1, 5}, {3, 1, 0}};
+		CHECK(g.insert_edges(gdwg::sorted_unique, edges.begin(), edges.end()) == 2);
+		auto expected = gdwg::graph<int, int>{1, 2, 3};
+		expected.insert_edge(1, 2, 1);
+		expected.insert_edge(3, 1, 0);
+		expected.insert_edge(1, 1, 5);
+		CHECK(g == expected);
+		CHECK(g.predecessors(1) == std::vector<int>{1, 3});
+	}
+}
+
+TEST_CASE("replace_node()", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<std::string, int>{"b", "d", "f", "h"};
+	g.insert_edge("d", "b", 1);
+	g.insert_edge("d", "f", 2);
+	g.insert_edge("d", "d", 3);
+	g.insert_edge("b", "d", 4);
+	g.insert_edge("h", "d", 5);
+	g.insert_edge("f", "h", 6);
+
+	auto const renamed = [](std::string const& to) {
+		auto expected = gdwg::graph<std::string, int>{"b", to, "f", "h"};
+		expected.insert_edge(to, "b", 1);
+		expected.insert_edge(to, "f", 2);
+		expected.insert_edge(to, to, 3);
+		expected.insert_edge("b", to, 4);
+		expected.insert_edge("h", to, 5);
+		expected.insert_edge("f", "h", 6);
+		return expected;
+	};
+	auto const printed = [](gdwg::graph<std::string, int> const& graph) {
+		auto out = std::ostringstream{};
+		out << graph;
+		return out.str();
+	};
+
+	SECTION("to a value between the same neighbours") {
+		CHECK(g.replace_node("d", "e"));
+		CHECK(g == renamed("e"));
+		CHECK(printed(g) == printed(renamed("e")));
+		CHECK(g.predecessors("e") == std::vector<std::string>{"b", "e", "h"});
+	}
+
+	SECTION("to a value that sorts elsewhere") {
+		CHECK(g.replace_node("d", "z"));
+		CHECK_FALSE(g.is_node("d"));
+		CHECK(g == renamed("z"));
+		CHECK(printed(g) == printed(renamed("z")));
+		CHECK(g.connections("z") == std::vector<std::string>{"b", "f", "z"});
+		CHECK(g.predecessors("z") == std::vector<std::string>{"b", "h", "z"});
+		CHECK(g.predecessors("b") == std::vector<std::string>{"z"});
+	}
+
+	SECTION("to a value that already exists") {
+		CHECK_FALSE(g.replace_node("d", "f"));
+		CHECK(g.is_connected("d", "f"));
+	}
+}
+
 TEST_CASE("merge_replace_node()", "[gdwg.modifiers]") {
 	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
 	g.insert_edge("wang", "liao", 1);
@@ -50,6 +242,21 @@ TEST_CASE("merge_replace_node()", "[gdwg.modifiers]") {
 	CHECK_FALSE(g.find("fan", "liao", 1) == g.end());
 }
 
+TEST_CASE("merge_replace_node() removes duplicate edges", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<std::string, int>{"A", "B", "C", "D"};
+	g.insert_edge("A", "B", 1);
+	g.insert_edge("A", "C", 2);
+	g.insert_edge("A", "D", 3);
+	g.insert_edge("B", "B", 1);
+	g.insert_edge("A", "A", 4);
+
+	g.merge_replace_node("A", "B");
+	auto expected_connections = std::vector<std::string>{"B", "B", "C", "D"};
+	CHECK(g.connections("B") == expected_connections);
+	CHECK(g.weights("B", "B") == std::vector<int>{1, 4});
+	CHECK_FALSE(g.is_node("A"));
+}
+
 TEST_CASE("erase_node()", "[gdwg.modifiers]") {
 	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
 	g.erase_node("wang");
@@ -90,6 +297,58 @@ TEST_CASE("erase_edge()", "[gdwg.modifiers]") {
 	}
 }
 
+TEST_CASE("erase_nodes()", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(2, 1, 2);
+	g.insert_edge(2, 2, 3);
+	g.insert_edge(2, 3, 4);
+	g.insert_edge(3, 4, 5);
+	g.insert_edge(4, 2, 6);
+	g.insert_edge(5, 1, 7);
+	g.insert_edge(5, 3, 8);
+
+	auto const values = std::vector<int>{2, 6, 1, 2};
+	CHECK(g.erase_nodes(values.begin(), values.end()) == 2);
+	CHECK(g.nodes() == std::vector<int>{3, 4, 5});
+	CHECK(g.connections(3) == std::vector<int>{4});
+	CHECK(g.connections(4).empty());
+	CHECK(g.connections(5) == std::vector<int>{3});
+	CHECK(g.predecessors(3) == std::vector<int>{5});
+	CHECK(g.predecessors(4) == std::vector<int>{3});
+
+	auto expected = gdwg::graph<int, int>{3, 4, 5};
+	expected.insert_edge(3, 4, 5);
+	expected.insert_edge(5, 3, 8);
+	CHECK(g == expected);
+	CHECK(g.erase_nodes(values.begin(), values.end()) == 0);
+
+	CHECK(g.insert_node(1));
+	CHECK(g.insert_edge(1, 3, 9));
+	CHECK(g.predecessors(3) == std::vector<int>{1, 5});
+}
+
+TEST_CASE("erase_edges()", "[gdwg.modifiers]") {
+	using edge = gdwg::graph<int, int>::value_type;
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(1, 2, 2);
+	g.insert_edge(2, 3, 3);
+	g.insert_edge(3, 3, 4);
+
+	auto const edges = std::vector<edge>{{1, 2, 2}, {3, 3, 4}, {1, 2, 5}, {3, 3, 4}};
+	CHECK(g.erase_edges(edges.begin(), edges.end()) == 2);
+	CHECK(g.weights(1, 2) == std::vector<int>{1});
+	CHECK_FALSE(g.is_connected(3, 3));
+	CHECK(g.predecessors(3) == std::vector<int>{2});
+
+	SECTION("through the graph's own iterators") {
+		CHECK(g.erase_edges(g.begin(), g.end()) == 2);
+		CHECK(g.begin() == g.end());
+		CHECK(g.nodes() == std::vector<int>{1, 2, 3});
+	}
+}
+
 TEST_CASE("clear()", "[gdwg.modifiers]") {
 	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
 	g.clear();
@@ -98,12 +357,143 @@ TEST_CASE("clear()", "[gdwg.modifiers]") {
 	CHECK(nodes == expected_nodes);
 }
 
+TEST_CASE("reserve() and shrink_to_fit()", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<int, int>{};
+	g.reserve(100, 300);
+	CHECK(g.node_capacity() >= 100);
+	auto const capacity = g.node_capacity();
+	for (auto i = 0; i < 100; ++i) {
+		g.insert_node(i);
+	}
+	g.insert_edge(0, 1, 1);
+	CHECK(g.node_capacity() == capacity);
+	CHECK(g.edge_capacity() == 1);
+
+	auto const doomed = std::vector<int>{50, 99, 98, 97};
+	g.erase_nodes(doomed.begin(), doomed.end());
+	g.shrink_to_fit();
+	CHECK(g.node_capacity() >= 96);
+	CHECK(g.node_capacity() < capacity);
+	CHECK(g.insert_node(100));
+	CHECK(g.insert_node(101));
+	CHECK(g.nodes().size() == 98);
+	CHECK(g.is_connected(0, 1));
+}
+
+TEST_CASE("tombstones and compact()", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("liao", "shi", 3);
+	g.insert_edge("shi", "shi", 4);
+	CHECK(g.max_dead_ratio() == 0);
+	CHECK(g.erase_edge("shi", "shi", 4));
+	CHECK(g.dead_edge_count() == 0);
+
+	g.max_dead_ratio(2);
+	CHECK(g.erase_edge("wang", "shi", 2));
+	g.erase_edge(g.find("liao", "shi", 3));
+	CHECK(g.dead_edge_count() == 2);
+	CHECK(g.connections("wang") == std::vector<std::string>{"liao"});
+	CHECK(g.predecessors("shi").empty());
+	CHECK(std::distance(g.begin(), g.end()) == 1);
+	CHECK_FALSE(g.is_connected("liao", "shi"));
+
+	SECTION("inserts reuse tombstones") {
+		CHECK(g.insert_edge("shi", "wang", 5));
+		CHECK(g.dead_edge_count() == 1);
+		CHECK(g.insert_edge("shi", "liao", 6));
+		CHECK(g.dead_edge_count() == 0);
+		CHECK(g.insert_edge("liao", "wang", 7));
+		CHECK(g.connections("shi") == std::vector<std::string>{"liao", "wang"});
+		CHECK(g.predecessors("wang") == std::vector<std::string>{"liao", "shi"});
+		CHECK(g.weights("shi", "liao") == std::vector<int>{6});
+	}
+
+	SECTION("passing the ratio compacts") {
+		CHECK(g.erase_edge("wang", "liao", 1));
+		CHECK(g.dead_edge_count() == 0);
+		CHECK(g.begin() == g.end());
+	}
+
+	SECTION("compact()") {
+		g.compact();
+		CHECK(g.dead_edge_count() == 0);
+		CHECK(g.insert_edge("wang", "shi", 2));
+		CHECK(g.connections("wang") == std::vector<std::string>{"liao", "shi"});
+	}
+
+	SECTION("lowering the ratio compacts") {
+		g.max_dead_ratio(0);
+		CHECK(g.dead_edge_count() == 0);
+	}
+
+	SECTION("copies don't share tombstones") {
+		auto const copy = g;
+		CHECK(copy.dead_edge_count() == 0);
+		CHECK(copy.max_dead_ratio() == 2);
+		CHECK(copy == g);
+	}
+}
+
+TEST_CASE("try_ modifiers", "[gdwg.modifiers]") {
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi"};
+
+	CHECK(g.try_insert_edge("wang", "liao", 1) == true);
+	CHECK(g.try_insert_edge("wang", "liao", 1) == false);
+	CHECK_FALSE(g.try_insert_edge("wang", "fan", 1).has_value());
+
+	CHECK(g.try_erase_edge("wang", "liao", 1) == true);
+	CHECK(g.try_erase_edge("wang", "liao", 1) == false);
+	CHECK_FALSE(g.try_erase_edge("fan", "liao", 1).has_value());
+
+	CHECK(g.try_replace_node("wang", "fan") == true);
+	CHECK(g.try_replace_node("fan", "liao") == false);
+	CHECK_FALSE(g.try_replace_node("wang", "chen").has_value());
+
+	g.insert_edge("fan", "shi", 1);
+	CHECK(g.try_merge_replace_node("fan", "liao"));
+	CHECK_FALSE(g.try_merge_replace_node("fan", "liao"));
+	CHECK(g.connections("liao") == std::vector<std::string>{"shi"});
+	CHECK(g.nodes() == std::vector<std::string>{"liao", "shi"});
+}
+
 TEST_CASE("exception", "[gdwg.modifiers]") {
 	SECTION("insert_edge()") {
 		auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
 		CHECK_THROWS_AS(g.insert_edge("", "liao", 1), std::runtime_error);
 		CHECK_THROWS_AS(g.insert_edge("wang", "", 1), std::runtime_error);
 		CHECK_THROWS_AS(g.insert_edge("", "", 1), std::runtime_error);
+		CHECK_THROWS_WITH(g.insert_edge("", "liao", 1),
+		                  "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node does "
+		                  "not exist");
+	}
+
+	SECTION("insert_edges()") {
+		auto g = gdwg::graph<std::string, int>{"wang", "liao"};
+		auto const edges = std::vector<gdwg::graph<std::string, int>::value_type>{
+		   {"wang", "liao", 1},
+		   {"liao", "", 2},
+		};
+		CHECK_THROWS_AS(g.insert_edges(edges.begin(), edges.end()), std::runtime_error);
+		CHECK_FALSE(g.is_connected("wang", "liao"));
+	}
+
+	SECTION("erase_edges()") {
+		auto g = gdwg::graph<std::string, int>{"wang", "liao"};
+		g.insert_edge("wang", "liao", 1);
+		auto const edges = std::vector<gdwg::graph<std::string, int>::value_type>{
+		   {"wang", "liao", 1},
+		   {"", "liao", 2},
+		};
+		CHECK_THROWS_AS(g.erase_edges(edges.begin(), edges.end()), std::runtime_error);
+		CHECK(g.is_connected("wang", "liao"));
+	}
+
+	SECTION("emplace_edge()") {
+		auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan", "chen"};
+		CHECK_THROWS_AS(g.emplace_edge("", "liao", 1), std::runtime_error);
+		CHECK_THROWS_AS(g.emplace_edge("wang", "", 1), std::runtime_error);
 	}
 
 	SECTION("replace_node()") {
@@ -0,0 +1,112 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.modifiers & gdwg.accessors to check that snapshots of a
+              gdwg::mvcc_graph never change, and that readers on other threads only ever see
+              versions the writer published whole.
+ * @approach:
+    * 1. Test modifiers and what they return.
+    * 2. Test a snapshot doesn't see later writes.
+    * 3. Test update() publishes several modifications at once.
+    * 4. Test readers on other threads while the writer modifies the graph.
+    * 5. Test exception.
+ */
+
+#include "gdwg/mvcc_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("mvcc_graph modifiers", "[gdwg.mvcc]") {
+	auto g = gdwg::mvcc_graph<std::string, int>{"wang", "liao"};
+	CHECK(g.insert_node("shi"));
+	CHECK_FALSE(g.insert_node("shi"));
+	CHECK(g.insert_edge("wang", "shi", 1));
+	CHECK_FALSE(g.insert_edge("wang", "shi", 1));
+	CHECK(g.insert_edge("shi", "liao", 2));
+	CHECK(g.erase_edge("wang", "shi", 1));
+	CHECK_FALSE(g.erase_edge("wang", "shi", 1));
+	CHECK(g.erase_node("liao"));
+	CHECK_FALSE(g.erase_node("liao"));
+
+	auto const snapshot = g.snapshot();
+	CHECK(snapshot.nodes() == std::vector<std::string>{"shi", "wang"});
+	CHECK(snapshot.connections("shi").empty());
+	CHECK(snapshot.connections("wang").empty());
+}
+
+TEST_CASE("mvcc_graph snapshot() doesn't see later writes", "[gdwg.mvcc]") {
+	auto g = gdwg::mvcc_graph<int, int>{1, 2};
+	g.insert_edge(1, 2, 3);
+	auto const before = g.snapshot();
+	g.erase_node(2);
+	g.insert_edge(1, 1, 4);
+
+	CHECK(before.nodes() == std::vector<int>{1, 2});
+	CHECK(before.weights(1, 2) == std::vector<int>{3});
+	CHECK_FALSE(before.is_connected(1, 1));
+	auto const after = g.snapshot();
+	CHECK(after.nodes() == std::vector<int>{1});
+	CHECK(after.is_connected(1, 1));
+}
+
+TEST_CASE("mvcc_graph update()", "[gdwg.mvcc]") {
+	auto g = gdwg::mvcc_graph<int, int>{1, 2};
+	g.update([](auto const& current) {
+		return current.insert_node(3).insert_edge(1, 3, 0).insert_edge(3, 1, 0);
+	});
+	CHECK(g.snapshot().connections(1) == std::vector<int>{3});
+	CHECK(g.snapshot().connections(3) == std::vector<int>{1});
+
+	auto const before = g.snapshot();
+	CHECK_THROWS_AS(g.update([](auto const& current) {
+		                return current.erase_node(1).insert_edge(1, 2, 0);
+	                }),
+	                std::runtime_error);
+	CHECK(g.snapshot() == before);
+}
+
+TEST_CASE("mvcc_graph readers on other threads", "[gdwg.mvcc]") {
+	constexpr auto nodes = 64;
+	auto g = gdwg::mvcc_graph<int, int>{};
+	auto done = std::atomic<bool>{false};
+	auto torn = std::atomic<int>{0};
+
+	// Every version the writer publishes has each edge together with its reverse, and a node's
+	// edges all share one weight.
+	auto readers = std::vector<std::thread>{};
+	for (auto r = 0; r < 4; ++r) {
+		readers.emplace_back([&] {
+			while (not done.load()) {
+				auto const snapshot = g.snapshot();
+				for (auto const& [from, to, weight] : snapshot) {
+					if (not snapshot.is_connected(to, from)
+					    or snapshot.weights(to, from) not_eq std::vector<int>{weight}) {
+						++torn;
+					}
+				}
+			}
+		});
+	}
+
+	for (auto i = 0; i < 2000; ++i) {
+		auto const a = (i * 7) % nodes;
+		auto const b = (i * 13 + 1) % nodes;
+		g.update([&](auto const& current) {
+			auto next = current.erase_node(a).erase_node(b).insert_node(a).insert_node(b);
+			return next.insert_edge(a, b, i).insert_edge(b, a, i);
+		});
+	}
+	done = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+	CHECK(torn == 0);
+}
+
+TEST_CASE("exception", "[gdwg.mvcc]") {
+	auto g = gdwg::mvcc_graph<std::string, int>{"wang", "liao"};
+	CHECK_THROWS_AS(g.insert_edge("wang", "", 1), std::runtime_error);
+	CHECK_THROWS_AS(g.erase_edge("", "liao", 1), std::runtime_error);
+	CHECK(g.snapshot().nodes() == std::vector<std::string>{"liao", "wang"});
+}
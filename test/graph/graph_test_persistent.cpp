@@ -0,0 +1,201 @@
+/* @date: 2026-10
+ * @rational: Mainly use gdwg.modifiers & gdwg.accessors to check that every version of a
+              gdwg::persistent_graph behaves like the gdwg::graph it would have been, and stays
+              that way while later versions are made from it.
+ * @approach:
+    * 1. Test constructors.
+    * 2. Test insert_node() and insert_edge() return new versions.
+    * 3. Test erase_edge() and erase_node().
+    * 4. Test many versions against the graph they should equal.
+    * 5. Test iterator traversal and find().
+    * 6. Test comparison and extractor.
+    * 7. Test exception.
+ */
+
+#include "gdwg/graph.hpp"
+#include "gdwg/persistent_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("persistent_graph constructors", "[gdwg.persistent]") {
+	CHECK(gdwg::persistent_graph<std::string, int>{}.empty());
+
+	auto const values = std::vector<std::string>{"wang", "liao", "wang"};
+	auto const from_range = gdwg::persistent_graph<std::string, int>(values.begin(), values.end());
+	CHECK(from_range.nodes() == std::vector<std::string>{"liao", "wang"});
+
+	auto g = gdwg::graph<std::string, int>{"wang", "liao", "shi", "fan"};
+	g.insert_edge("wang", "liao", 1);
+	g.insert_edge("wang", "shi", 2);
+	g.insert_edge("liao", "fan", 3);
+	g.insert_edge("fan", "wang", 4);
+	g.insert_edge("fan", "fan", 5);
+	auto const expected = gdwg::persistent_graph<std::string, int>{"wang", "liao", "shi", "fan"}
+	                         .insert_edge("wang", "liao", 1)
+	                         .insert_edge("wang", "shi", 2)
+	                         .insert_edge("liao", "fan", 3)
+	                         .insert_edge("fan", "wang", 4)
+	                         .insert_edge("fan", "fan", 5);
+	CHECK(gdwg::persistent_graph<std::string, int>(g) == expected);
+}
+
+TEST_CASE("persistent_graph insert_node() and insert_edge()", "[gdwg.persistent]") {
+	auto const v1 = gdwg::persistent_graph<std::string, int>{"wang", "liao"};
+	auto const v2 = v1.insert_node("shi");
+	auto const v3 = v2.insert_edge("wang", "shi", 1);
+	auto const v4 = v3.insert_edge("wang", "shi", 0);
+
+	CHECK(v1.nodes() == std::vector<std::string>{"liao", "wang"});
+	CHECK(v2.nodes() == std::vector<std::string>{"liao", "shi", "wang"});
+	CHECK_FALSE(v2.is_connected("wang", "shi"));
+	CHECK(v3.weights("wang", "shi") == std::vector<int>{1});
+	CHECK(v4.weights("wang", "shi") == std::vector<int>{0, 1});
+	CHECK(v4.connections("wang") == std::vector<std::string>{"shi", "shi"});
+
+	CHECK(v4.insert_node("wang") == v4);
+	CHECK(v4.insert_edge("wang", "shi", 1) == v4);
+}
+
+TEST_CASE("persistent_graph erase_edge() and erase_node()", "[gdwg.persistent]") {
+	auto const g = gdwg::persistent_graph<std::string, int>{"wang", "liao", "shi", "fan"}
+	                  .insert_edge("wang", "liao", 1)
+	                  .insert_edge("wang", "shi", 2)
+	                  .insert_edge("liao", "fan", 3)
+	                  .insert_edge("fan", "wang", 4)
+	                  .insert_edge("fan", "fan", 5);
+
+	SECTION("erase_edge()") {
+		auto const erased = g.erase_edge("wang", "liao", 1);
+		CHECK_FALSE(erased.is_connected("wang", "liao"));
+		CHECK(g.is_connected("wang", "liao"));
+		CHECK(erased.erase_edge("wang", "liao", 1) == erased);
+	}
+
+	SECTION("erase_node()") {
+		auto const erased = g.erase_node("fan");
+		CHECK(erased.nodes() == std::vector<std::string>{"liao", "shi", "wang"});
+		CHECK(erased.connections("liao").empty());
+		CHECK(erased.connections("wang") == std::vector<std::string>{"liao", "shi"});
+		CHECK(g.connections("liao") == std::vector<std::string>{"fan"});
+		CHECK(erased.erase_node("fan") == erased);
+
+		// The incoming edges of wang no longer include the one from fan.
+		auto const again = erased.insert_node("fan").insert_edge("wang", "fan", 6);
+		CHECK(again.erase_node("wang").nodes() == std::vector<std::string>{"fan", "liao", "shi"});
+		CHECK(again.erase_node("wang").connections("fan").empty());
+	}
+}
+
+TEST_CASE("persistent_graph versions match graph", "[gdwg.persistent]") {
+	auto versions = std::vector<gdwg::persistent_graph<int, int>>(1);
+	auto expected = std::vector<gdwg::graph<int, int>>(1);
+	for (auto i = 0; i < 300; ++i) {
+		auto next = versions.back();
+		auto g = expected.back();
+		auto const a = (i * 37) % 40;
+		auto const b = (i * 11) % 40;
+		switch (i % 5) {
+		case 0:
+		case 1:
+			next = next.insert_node(a).insert_node(b);
+			g.insert_node(a);
+			g.insert_node(b);
+			break;
+		case 2:
+		case 3:
+			if (g.is_node(a) and g.is_node(b)) {
+				next = next.insert_edge(a, b, i % 4);
+				g.insert_edge(a, b, i % 4);
+			}
+			break;
+		default:
+			next = next.erase_node(a);
+			g.erase_node(a);
+			break;
+		}
+		versions.push_back(next);
+		expected.push_back(g);
+	}
+
+	for (auto i = std::size_t{0}; i < versions.size(); ++i) {
+		REQUIRE(versions[i] == gdwg::persistent_graph<int, int>(expected[i]));
+		for (auto const n : expected[i].nodes()) {
+			CHECK(versions[i].connections(n) == expected[i].connections(n));
+		}
+	}
+}
+
+TEST_CASE("persistent_graph iterator", "[gdwg.persistent]") {
+	auto const g = gdwg::persistent_graph<std::string, int>{"wang", "liao", "shi", "fan"}
+	                  .insert_edge("wang", "liao", 1)
+	                  .insert_edge("wang", "shi", 2)
+	                  .insert_edge("liao", "fan", 3)
+	                  .insert_edge("fan", "wang", 4)
+	                  .insert_edge("fan", "fan", 5);
+	auto const expected = std::vector<std::tuple<std::string, std::string, int>>{
+	   {"fan", "fan", 5},
+	   {"fan", "wang", 4},
+	   {"liao", "fan", 3},
+	   {"wang", "liao", 1},
+	   {"wang", "shi", 2},
+	};
+	auto it = g.begin();
+	for (auto const& [from, to, weight] : expected) {
+		REQUIRE_FALSE(it == g.end());
+		CHECK((*it).from == from);
+		CHECK((*it).to == to);
+		CHECK((*it).weight == weight);
+		++it;
+	}
+	CHECK(it == g.end());
+	auto const no_edges = gdwg::persistent_graph<std::string, int>{"wang"};
+	CHECK(no_edges.begin() == no_edges.end());
+
+	auto const found = g.find("liao", "fan", 3);
+	REQUIRE_FALSE(found == g.end());
+	CHECK((*std::next(found)).from == "wang");
+	CHECK(g.find("liao", "fan", 4) == g.end());
+	CHECK(g.find("chen", "fan", 3) == g.end());
+}
+
+TEST_CASE("persistent_graph comparison and extractor", "[gdwg.persistent]") {
+	auto const g = gdwg::persistent_graph<std::string, int>{"wang", "liao", "shi", "fan"}
+	                  .insert_edge("wang", "liao", 1)
+	                  .insert_edge("wang", "shi", 2)
+	                  .insert_edge("liao", "fan", 3)
+	                  .insert_edge("fan", "wang", 4)
+	                  .insert_edge("fan", "fan", 5);
+	CHECK(g
+	      == gdwg::persistent_graph<std::string, int>{"fan", "shi", "liao", "wang"}
+	            .insert_edge("fan", "fan", 5)
+	            .insert_edge("fan", "wang", 4)
+	            .insert_edge("liao", "fan", 3)
+	            .insert_edge("wang", "shi", 2)
+	            .insert_edge("wang", "liao", 1));
+	CHECK_FALSE(g == g.insert_node("chen"));
+	CHECK(g == g.insert_node("chen").erase_node("chen"));
+
+	auto const nodes = g.nodes();
+	auto expected = std::ostringstream{};
+	expected << gdwg::graph<std::string, int>(nodes.begin(), nodes.end());
+	auto out = std::ostringstream{};
+	out << gdwg::persistent_graph<std::string, int>{"fan", "liao", "shi", "wang"};
+	CHECK(out.str() == expected.str());
+	auto edges = std::ostringstream{};
+	edges << g.erase_node("shi").erase_node("liao");
+	CHECK(edges.str() == "fan (\n  fan | 5\n  wang | 4\n)\nwang (\n)\n");
+}
+
+TEST_CASE("exception", "[gdwg.persistent]") {
+	auto const g = gdwg::persistent_graph<std::string, int>{"wang", "liao", "shi", "fan"}
+	                  .insert_edge("wang", "liao", 1)
+	                  .insert_edge("wang", "shi", 2)
+	                  .insert_edge("liao", "fan", 3)
+	                  .insert_edge("fan", "wang", 4)
+	                  .insert_edge("fan", "fan", 5);
+	CHECK_THROWS_AS(g.insert_edge("wang", "", 1), std::runtime_error);
+	CHECK_THROWS_AS(g.erase_edge("", "liao", 1), std::runtime_error);
+	CHECK_THROWS_AS(g.is_connected("wang", ""), std::runtime_error);
+	CHECK_THROWS_AS(g.weights("", "liao"), std::runtime_error);
+	CHECK_THROWS_AS(g.connections(""), std::runtime_error);
+}